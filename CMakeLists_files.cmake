@@ -62,6 +62,7 @@ list(APPEND MAIN_SOURCE_FILES
   lib/eclipse/EclipseState/SummaryConfig/SummaryConfig.cpp
   lib/eclipse/EclipseState/Tables/ColumnSchema.cpp
   lib/eclipse/EclipseState/Tables/JFunc.cpp
+  lib/eclipse/EclipseState/Tables/PvtxEvaluator.cpp
   lib/eclipse/EclipseState/Tables/PvtxTable.cpp
   lib/eclipse/EclipseState/Tables/SimpleTable.cpp
   lib/eclipse/EclipseState/Tables/TableColumn.cpp
@@ -71,7 +72,10 @@ list(APPEND MAIN_SOURCE_FILES
   lib/eclipse/EclipseState/Tables/TableSchema.cpp
   lib/eclipse/EclipseState/Tables/Tables.cpp
   lib/eclipse/EclipseState/Tables/VFPInjTable.cpp
+  lib/eclipse/EclipseState/Tables/VFPInterpolator.cpp
   lib/eclipse/EclipseState/Tables/VFPProdTable.cpp
+  lib/eclipse/Parser/DeckCache.cpp
+  lib/eclipse/Parser/DeckNameHash.cpp
   lib/eclipse/Parser/MessageContainer.cpp
   lib/eclipse/Parser/ParseContext.cpp
   lib/eclipse/Parser/Parser.cpp
@@ -85,6 +89,7 @@ list(APPEND MAIN_SOURCE_FILES
   lib/eclipse/Units/Dimension.cpp
   lib/eclipse/Units/UnitSystem.cpp
   lib/eclipse/Utility/Functional.cpp
+  lib/eclipse/Utility/Intern.cpp
   lib/eclipse/Utility/Stringview.cpp
 )
 
@@ -116,6 +121,7 @@ list (APPEND TEST_SOURCE_FILES
   lib/eclipse/tests/CompletionTests.cpp
   lib/eclipse/tests/COMPSEGUnits.cpp
   lib/eclipse/tests/CopyRegTests.cpp
+  lib/eclipse/tests/DeckCacheTests.cpp
   lib/eclipse/tests/DeckTests.cpp
   lib/eclipse/tests/DynamicStateTests.cpp
   lib/eclipse/tests/DynamicVectorTests.cpp
@@ -130,6 +136,7 @@ list (APPEND TEST_SOURCE_FILES
   lib/eclipse/tests/GridPropertyTests.cpp
   lib/eclipse/tests/GroupTests.cpp
   lib/eclipse/tests/InitConfigTest.cpp
+  lib/eclipse/tests/InternTests.cpp
   lib/eclipse/tests/IOConfigTests.cpp
   lib/eclipse/tests/MessageContainerTest.cpp
   lib/eclipse/tests/MessageLimitTests.cpp
@@ -161,6 +168,7 @@ list (APPEND TEST_SOURCE_FILES
   lib/eclipse/tests/TuningTests.cpp
   lib/eclipse/tests/UnitTests.cpp
   lib/eclipse/tests/ValueTests.cpp
+  lib/eclipse/tests/VFPInterpolatorTests.cpp
   lib/eclipse/tests/WellSolventTests.cpp
   lib/eclipse/tests/WellTests.cpp
 )
@@ -7,6 +7,7 @@ set(genkw_SOURCES lib/json/JsonObject.cpp
                   lib/eclipse/Deck/DeckOutput.cpp
                   lib/eclipse/Generator/KeywordGenerator.cpp
                   lib/eclipse/Generator/KeywordLoader.cpp
+                  lib/eclipse/Parser/DeckNameHash.cpp
                   lib/eclipse/Parser/MessageContainer.cpp
                   lib/eclipse/Parser/ParseContext.cpp
                   lib/eclipse/Parser/ParserEnums.cpp
@@ -18,6 +19,7 @@ set(genkw_SOURCES lib/json/JsonObject.cpp
                   lib/eclipse/RawDeck/StarToken.cpp
                   lib/eclipse/Units/Dimension.cpp
                   lib/eclipse/Units/UnitSystem.cpp
+                  lib/eclipse/Utility/Intern.cpp
                   lib/eclipse/Utility/Stringview.cpp
 )
 if(NOT cjson_FOUND)
@@ -23,6 +23,7 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include <cmath>
@@ -60,11 +61,11 @@ const std::vector< std::string >& DeckItem::value_ref< std::string >() const {
     return this->sval;
 }
 
-DeckItem::DeckItem( const std::string& nm ) : item_name( nm ) {}
+DeckItem::DeckItem( const std::string& nm ) : item_name( &intern( nm ) ) {}
 
 DeckItem::DeckItem( const std::string& nm, int, size_t hint ) :
     type( get_type< int >() ),
-    item_name( nm )
+    item_name( &intern( nm ) )
 {
     this->ival.reserve( hint );
     this->defaulted.reserve( hint );
@@ -72,7 +73,7 @@ DeckItem::DeckItem( const std::string& nm, int, size_t hint ) :
 
 DeckItem::DeckItem( const std::string& nm, double, size_t hint ) :
     type( get_type< double >() ),
-    item_name( nm )
+    item_name( &intern( nm ) )
 {
     this->dval.reserve( hint );
     this->defaulted.reserve( hint );
@@ -80,14 +81,14 @@ DeckItem::DeckItem( const std::string& nm, double, size_t hint ) :
 
 DeckItem::DeckItem( const std::string& nm, std::string, size_t hint ) :
     type( get_type< std::string >() ),
-    item_name( nm )
+    item_name( &intern( nm ) )
 {
     this->sval.reserve( hint );
     this->defaulted.reserve( hint );
 }
 
 const std::string& DeckItem::name() const {
-    return this->item_name;
+    return *this->item_name;
 }
 
 bool DeckItem::defaultApplied( size_t index ) const {
@@ -133,6 +134,7 @@ void DeckItem::push( T x ) {
 
     val.push_back( std::move( x ) );
     this->defaulted.push_back( false );
+    this->SIconverted = false;
 }
 
 void DeckItem::push_back( int x ) {
@@ -153,6 +155,7 @@ void DeckItem::push( T x, size_t n ) {
 
     val.insert( val.end(), n, x );
     this->defaulted.insert( this->defaulted.end(), n, false );
+    this->SIconverted = false;
 }
 
 void DeckItem::push_back( int x, size_t n ) {
@@ -176,6 +179,7 @@ void DeckItem::push_default( T x ) {
 
     val.push_back( std::move( x ) );
     this->defaulted.push_back( true );
+    this->SIconverted = false;
 }
 
 void DeckItem::push_backDefault( int x ) {
@@ -210,29 +214,66 @@ double DeckItem::getSIDouble( size_t index ) const {
 
 const std::vector< double >& DeckItem::getSIDoubleData() const {
     const auto& raw = this->value_ref< double >();
-    // we already converted this item to SI?
-    if( !this->SIdata.empty() ) return this->SIdata;
+    if( !this->SIconverted ) this->convert();
+
+    return this->SIdata.empty() ? raw : this->SIdata;
+}
+
+void DeckItem::convertToSI() const {
+    if( this->type != type_tag::fdouble || this->dimensions.empty() ) return;
+    if( this->SIconverted ) return;
+
+    /*
+     * Items with a context dependent unit can not be converted, and are
+     * left to throw when their SI data is requested.
+     */
+    try {
+        this->convert();
+    } catch( const std::logic_error& ) {}
+}
+
+void DeckItem::convert() const {
+    const auto& raw = this->value_ref< double >();
 
     if( this->dimensions.empty() )
         throw std::invalid_argument("No dimension has been set for item'"
                                     + this->name()
                                     + "'; can not ask for SI data");
 
+    const auto identity = []( const Dimension& dim ) {
+        return dim.getSIScaling() == 1.0 && dim.getSIOffset() == 0.0;
+    };
+
     /*
-     * This is an unobservable state change - SIData is lazily converted to
-     * SI units, so externally the object still behaves as const
+     * Only the dimensions which apply to a value are looked at, a
+     * context dependent dimension throws when asked for its scaling,
+     * and must not do so for an item without values.
      */
-    const auto dim_size = dimensions.size();
+    const auto dim_size = this->dimensions.size();
     const auto sz = raw.size();
+    const auto used = this->dimensions.begin() + std::min( dim_size, sz );
+
+    if( std::all_of( this->dimensions.begin(), used, identity ) ) {
+        this->SIdata.clear();
+        this->SIconverted = true;
+        return;
+    }
+
+    /*
+     * The dimensions are applied cyclically, so convert one dimension at
+     * the time with a strided scale and offset; for the common case of a
+     * single dimension this is a plain loop over contiguous data.
+     */
     this->SIdata.resize( sz );
 
-    for( size_t index = 0; index < sz; index++ ) {
-        const auto dimIndex = index % dim_size;
-        this->SIdata[ index ] = this->dimensions[ dimIndex ]
-                                .convertRawToSi( raw[ index ] );
+    for( size_t d = 0; d < dim_size && d < sz; ++d ) {
+        const double factor = this->dimensions[ d ].getSIScaling();
+        const double offset = this->dimensions[ d ].getSIOffset();
+        for( size_t index = d; index < sz; index += dim_size )
+            this->SIdata[ index ] = raw[ index ] * factor + offset;
     }
 
-    return this->SIdata;
+    this->SIconverted = true;
 }
 
 void DeckItem::push_backDimension( const Dimension& active,
@@ -242,6 +283,7 @@ void DeckItem::push_backDimension( const Dimension& active,
                             || this->defaultApplied( ds.size() - 1 );
 
     this->dimensions.push_back( dim_inactive ? def : active );
+    this->SIconverted = false;
 }
 
 type_tag DeckItem::getType() const {
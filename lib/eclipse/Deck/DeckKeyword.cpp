@@ -25,7 +25,7 @@
 namespace Opm {
 
     DeckKeyword::DeckKeyword(const std::string& keywordName) :
-        m_keywordName(keywordName),
+        m_keywordName( &intern( keywordName ) ),
         m_lineNumber(-1),
         m_knownKeyword(true),
         m_isDataKeyword(false),
@@ -34,7 +34,7 @@ namespace Opm {
     }
 
     DeckKeyword::DeckKeyword(const std::string& keywordName, bool knownKeyword) :
-        m_keywordName(keywordName),
+        m_keywordName( &intern( keywordName ) ),
         m_lineNumber(-1),
         m_knownKeyword(knownKeyword),
         m_isDataKeyword(false),
@@ -48,12 +48,17 @@ namespace Opm {
     }
 
     void DeckKeyword::setLocation(const std::string& fileName, int lineNumber) {
-        m_fileName = fileName;
+        setLocation( std::make_shared< const std::string >( fileName ), lineNumber );
+    }
+
+    void DeckKeyword::setLocation(std::shared_ptr< const std::string > fileName, int lineNumber) {
+        m_fileName = std::move( fileName );
         m_lineNumber = lineNumber;
     }
 
     const std::string& DeckKeyword::getFileName() const {
-        return m_fileName;
+        static const std::string nofile;
+        return m_fileName ? *m_fileName : nofile;
     }
 
     int DeckKeyword::getLineNumber() const {
@@ -70,7 +75,7 @@ namespace Opm {
 
 
     const std::string& DeckKeyword::name() const {
-        return m_keywordName;
+        return *m_keywordName;
     }
 
     size_t DeckKeyword::size() const {
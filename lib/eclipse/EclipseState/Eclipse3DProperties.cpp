@@ -19,6 +19,8 @@
 
 #include <algorithm>
 #include <functional>
+#include <map>
+#include <memory>
 #include <set>
 
 #include <opm/parser/eclipse/Deck/Deck.hpp>
@@ -33,6 +35,7 @@
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
 #include <opm/parser/eclipse/Utility/String.hpp>
 
+#include "Grid/parallel_for.hpp"
 #include "Grid/setKeywordBox.hpp"
 
 namespace Opm {
@@ -51,57 +54,39 @@ namespace Opm {
             }
         }
 
-        // this funcion applies a single pore volume multiplier (i.e., it deals with a single
-        // record of the MULTREGP keyword)
-        void applyPorosityRegionMultiplier_(std::vector<double>& porev,
-                                            const std::vector<int>& regionId,
-                                            int multRegionId,
-                                            double multValue)
-        {
-            for (unsigned i = 0; i < porev.size(); ++i) {
-                if (regionId[i] == multRegionId)
-                    porev[i] *= multValue;
-            }
-        }
-
-        /// this function initializes the pore volume of all cells. it uses the raw keyword
-        /// 'MULTREGP', the integer grid properties 'FLUXNUM', 'MULTNUM' and 'OPERNUM' as
-        /// well as the double grid properties 'PORV', 'PORO', 'NTG' and 'MULTPV'
-        void initPORV( std::vector<double>&    values,
-                       const Deck* deck,
-                       const EclipseGrid*      eclipseGrid,
-                       const GridProperties<int>* intGridProperties,
-                       const GridProperties<double>* doubleGridProperties)
-        {
-            if ( doubleGridProperties->hasKeyword("PORO") ) {
-                const auto& poro = doubleGridProperties->getKeyword("PORO");
-                const auto& ntg =  doubleGridProperties->getKeyword("NTG");
-
-                const auto& poroData = poro.getData();
-                for (size_t globalIndex = 0; globalIndex < poro.getCartesianSize(); globalIndex++) {
-                    if (!std::isfinite(values[globalIndex])) {
-                        double cell_poro = poroData[globalIndex];
-                        if (std::isnan(cell_poro))
-                            throw std::logic_error("Some cells neither specify the PORV keyword nor PORO");
-
-                        double cell_ntg = ntg.iget(globalIndex);
-                        double cell_volume = eclipseGrid->getCellVolume(globalIndex);
-                        values[globalIndex] = cell_poro * cell_volume * cell_ntg;
-                    }
+        /*
+          The pore volume multipliers of the MULTREGP keyword, as a table
+          of region value -> multiplier for each of the region arrays used.
+          Only the last record of a region value is used, so a cell is in
+          at most one region of every array; the multipliers of a cell are
+          applied in record order.
+        */
+        struct PorvRegionMultipliers {
+            std::vector< const std::vector< int >* > regions;
+            std::vector< std::vector< int > > records;
+            std::vector< double > multipliers;
+
+            void apply( size_t globalIndex, double& porv ) const {
+                int matches[ 3 ];
+                size_t count = 0;
+                for (size_t r = 0; r < this->regions.size(); r++) {
+                    const int region = (*this->regions[r])[globalIndex];
+                    const auto& table = this->records[r];
+                    if (region >= 0 && size_t( region ) < table.size() && table[region] >= 0)
+                        matches[count++] = table[region];
                 }
-            }
-            else {
-                for (size_t globalIndex = 0; globalIndex < values.size(); globalIndex++)
-                    if ( !std::isfinite(values[globalIndex]) )
-                        throw std::logic_error("Some cells neither specify the PORV keyword nor PORO");
-            }
 
-            if (doubleGridProperties->hasKeyword("MULTPV")) {
-                const GridProperty<double>& multpvKeyword = doubleGridProperties->getKeyword("MULTPV");
-                const auto& multpvData = multpvKeyword.getData();
-                for (size_t globalIndex = 0; globalIndex < multpvData.size(); globalIndex++)
-                    values[globalIndex] *= multpvData[globalIndex];
+                std::sort( matches, matches + count );
+                for (size_t m = 0; m < count; m++)
+                    porv *= this->multipliers[ matches[m] ];
             }
+        };
+
+        PorvRegionMultipliers porvRegionMultipliers( const Deck* deck,
+                                                     const GridProperties<int>* intGridProperties )
+        {
+            PorvRegionMultipliers table;
+            std::map< std::string, std::map< int, int > > positions;
 
             // deal with the region multiplier for porosity
             if (deck->hasKeyword("MULTREGP")) {
@@ -134,22 +119,78 @@ namespace Opm {
                         // the region was specified twice
                         continue;
 
-                    if (regionType == "M") {
-                        const GridProperty<int>& multnumProp = intGridProperties->getKeyword("MULTNUM");
-                        applyPorosityRegionMultiplier_(values, multnumProp.getData(), regionId, multValue);
-                    }
-                    else if (regionType == "F") {
-                        const GridProperty<int>& fluxnumProp = intGridProperties->getKeyword("FLUXNUM");
-                        applyPorosityRegionMultiplier_(values, fluxnumProp.getData(), regionId, multValue);
-                    }
-                    else if (regionType == "O") {
-                        const GridProperty<int>& opernumProp = intGridProperties->getKeyword("OPERNUM");
-                        applyPorosityRegionMultiplier_(values, opernumProp.getData(), regionId, multValue);
-                    }
+                    std::string regionArray;
+                    if (regionType == "M")
+                        regionArray = "MULTNUM";
+                    else if (regionType == "F")
+                        regionArray = "FLUXNUM";
+                    else if (regionType == "O")
+                        regionArray = "OPERNUM";
                     else
                         throw std::logic_error("Unknown or illegal region type for MULTREGP keyword: '"+regionType+"'");
+
+                    positions[ regionArray ][ regionId ] = table.multipliers.size();
+                    table.multipliers.push_back( multValue );
                 }
             }
+
+            for (const auto& array : positions) {
+                table.regions.push_back( &intGridProperties->getKeyword( array.first ).getData() );
+
+                std::vector< int > records( array.second.rbegin()->first + 1, -1 );
+                for (const auto& position : array.second)
+                    records[ position.first ] = position.second;
+
+                table.records.push_back( std::move( records ) );
+            }
+
+            return table;
+        }
+
+        /// this function initializes the pore volume of all cells. it uses the raw keyword
+        /// 'MULTREGP', the integer grid properties 'FLUXNUM', 'MULTNUM' and 'OPERNUM' as
+        /// well as the double grid properties 'PORV', 'PORO', 'NTG' and 'MULTPV'. All the
+        /// input is looked up first, and the pore volume of every cell is then computed
+        /// in a single pass over the grid, split over up to threads threads.
+        void initPORV( std::vector<double>&    values,
+                       const Deck* deck,
+                       const EclipseGrid*      eclipseGrid,
+                       const GridProperties<int>* intGridProperties,
+                       const GridProperties<double>* doubleGridProperties,
+                       size_t threads)
+        {
+            const std::vector< double >* poro = nullptr;
+            const std::vector< double >* ntg = nullptr;
+            const std::vector< double >* multpv = nullptr;
+
+            if ( doubleGridProperties->hasKeyword("PORO") ) {
+                poro = &doubleGridProperties->getKeyword("PORO").getData();
+                ntg = &doubleGridProperties->getKeyword("NTG").getData();
+            }
+
+            if (doubleGridProperties->hasKeyword("MULTPV"))
+                multpv = &doubleGridProperties->getKeyword("MULTPV").getData();
+
+            const auto regionMultipliers = porvRegionMultipliers( deck, intGridProperties );
+
+            parallel_for( values.size(), threads, [&]( size_t begin, size_t end ) {
+                for (size_t globalIndex = begin; globalIndex < end; globalIndex++) {
+                    double& porv = values[globalIndex];
+
+                    if (!std::isfinite(porv)) {
+                        if (!poro || std::isnan((*poro)[globalIndex]))
+                            throw std::logic_error("Some cells neither specify the PORV keyword nor PORO");
+
+                        double cell_volume = eclipseGrid->getCellVolume(globalIndex);
+                        porv = (*poro)[globalIndex] * cell_volume * (*ntg)[globalIndex];
+                    }
+
+                    if (multpv)
+                        porv *= (*multpv)[globalIndex];
+
+                    regionMultipliers.apply( globalIndex, porv );
+                }
+            });
         }
 
 
@@ -444,7 +485,8 @@ namespace Opm {
 
     Eclipse3DProperties::Eclipse3DProperties( const Deck&         deck,
                                               const TableManager& tableManager,
-                                              const EclipseGrid&  eclipseGrid)
+                                              const EclipseGrid&  eclipseGrid,
+                                              size_t              threads)
         :
 
           m_defaultRegion("FLUXNUM"),
@@ -454,7 +496,8 @@ namespace Opm {
           // register the grid properties
           m_intGridProperties(eclipseGrid, makeSupportedIntKeywords()),
           m_doubleGridProperties(eclipseGrid, &m_deckUnitSystem,
-                                 makeSupportedDoubleKeywords(&tableManager, &eclipseGrid, &m_intGridProperties))
+                                 makeSupportedDoubleKeywords(&tableManager, &eclipseGrid, &m_intGridProperties)),
+          m_threads(threads)
     {
         /*
          * The EQUALREG, MULTREG, COPYREG, ... keywords are used to manipulate
@@ -501,7 +544,8 @@ namespace Opm {
                                       &deck,
                                       &eclipseGrid,
                                       &m_intGridProperties,
-                                      &m_doubleGridProperties);
+                                      &m_doubleGridProperties,
+                                      threads);
 
             m_doubleGridProperties.postAddKeyword( "PORV",
                                                    std::numeric_limits<double>::quiet_NaN(),
@@ -574,22 +618,50 @@ namespace Opm {
         return m_defaultRegion;
     }
 
+    std::string Eclipse3DProperties::getRegionName( const DeckItem& regionItem ) const {
+        if (regionItem.defaultApplied(0))
+            return m_defaultRegion;
+        else
+            return MULTREGT::RegionNameFromDeckValue( regionItem.get< std::string >(0) );
+    }
+
     const GridProperty<int>& Eclipse3DProperties::getRegion( const DeckItem& regionItem ) const {
         if (regionItem.defaultApplied(0))
             return m_intGridProperties.getKeyword( m_defaultRegion );
-        else {
-            const std::string regionArray = MULTREGT::RegionNameFromDeckValue( regionItem.get< std::string >(0) );
-            return m_intGridProperties.getDeckKeyword( regionArray );
-        }
+        else
+            return m_intGridProperties.getDeckKeyword( getRegionName( regionItem ) );
+    }
+
+    void Eclipse3DProperties::compress( const EclipseGrid& eclipseGrid ) {
+        auto activeIndex = std::make_shared< std::vector< int > >( eclipseGrid.getCartesianSize(), -1 );
+        const auto& activeMap = eclipseGrid.getActiveMap();
+        for (size_t activeIdx = 0; activeIdx < activeMap.size(); activeIdx++)
+            (*activeIndex)[ activeMap[ activeIdx ] ] = activeIdx;
+
+        /*
+          The post processors read the full data of other properties, so
+          they must all have run before the first property is compressed;
+          ACTNUM is looked up since it creates PORV.
+        */
+        getIntGridProperty( "ACTNUM" );
+        for (auto& pair : m_intGridProperties.m_properties)
+            pair.second.runPostProcessor();
+
+        for (auto& pair : m_doubleGridProperties.m_properties)
+            pair.second.runPostProcessor();
+
+        m_intGridProperties.compress( activeIndex );
+        m_doubleGridProperties.compress( activeIndex );
     }
 
     std::vector< int > Eclipse3DProperties::getRegions( const std::string& keyword ) const {
         if( !this->hasDeckIntGridProperty( keyword ) ) return {};
 
         const auto& property = this->getIntGridProperty( keyword );
+        const auto& data = property.isCompressed() ? property.getCompressedData()
+                                                   : property.getData();
 
-        std::set< int > regions( property.getData().begin(),
-                                 property.getData().end() );
+        std::set< int > regions( data.begin(), data.end() );
 
         return { regions.begin(), regions.end() };
     }
@@ -812,15 +884,46 @@ namespace Opm {
         }
     }
 
+    /*
+      Split the records of a region keyword into groups of consecutive
+      records working on the same arrays, which are applied with a single
+      pass over the region array. A record which modifies its own region
+      array makes a group on its own, since the records after it must see
+      the modified region values.
+    */
+    std::vector< std::vector< const DeckRecord* > > Eclipse3DProperties::groupRegionRecords( const DeckKeyword& deckKeyword ) const {
+        std::vector< std::vector< const DeckRecord* > > groups;
+        std::string previous;
+
+        for( const auto& record : deckKeyword ) {
+            const auto& regionItem = record.getItem("REGION_NAME");
+            const std::string region = getRegionName( regionItem );
+            const std::string& array = record.getItem("ARRAY").get< std::string >(0);
+            const std::string target = record.hasItem("TARGET_ARRAY")
+                                     ? record.getItem("TARGET_ARRAY").get< std::string >(0)
+                                     : array;
+            const std::string key = array + " " + target + " " + region
+                                  + (regionItem.defaultApplied(0) ? " *" : "");
+
+            if( groups.empty() || key != previous )
+                groups.emplace_back();
+
+            groups.back().push_back( &record );
+            previous = target == region ? std::string() : key;
+        }
+
+        return groups;
+    }
+
     void Eclipse3DProperties::handleEQUALREGKeyword( const DeckKeyword& deckKeyword) {
-       for( const auto& record : deckKeyword ) {
-           const std::string& targetArray = record.getItem("ARRAY").get< std::string >(0);
-           auto& regionProperty = getRegion( record.getItem("REGION_NAME") );
+       for( const auto& records : groupRegionRecords( deckKeyword ) ) {
+           const std::string& targetArray = records.front()->getItem("ARRAY").get< std::string >(0);
+           auto& regionProperty = getRegion( records.front()->getItem("REGION_NAME") );
 
            if (m_intGridProperties.supportsKeyword( targetArray ))
-               m_intGridProperties.handleEQUALREGRecord( record , regionProperty );
+               m_intGridProperties.handleEQUALREGRecords( records , regionProperty, m_threads );
            else if (m_doubleGridProperties.supportsKeyword( targetArray ))
-               m_doubleGridProperties.handleEQUALREGRecord( record , regionProperty );
+               m_doubleGridProperties.handleEQUALREGRecords( records , regionProperty, m_threads );
            else
                throw std::invalid_argument("Fatal error processing EQUALREG keyword - invalid/undefined keyword: " + targetArray);
        }
@@ -828,14 +931,14 @@ namespace Opm {
 
 
     void Eclipse3DProperties::handleADDREGKeyword( const DeckKeyword& deckKeyword) {
-       for( const auto& record : deckKeyword ) {
-           const std::string& targetArray = record.getItem("ARRAY").get< std::string >(0);
-           const auto& regionProperty = getRegion( record.getItem("REGION_NAME") );
+       for( const auto& records : groupRegionRecords( deckKeyword ) ) {
+           const std::string& targetArray = records.front()->getItem("ARRAY").get< std::string >(0);
+           const auto& regionProperty = getRegion( records.front()->getItem("REGION_NAME") );
 
            if (m_intGridProperties.supportsKeyword( targetArray ))
-               m_intGridProperties.handleADDREGRecord( record , regionProperty );
+               m_intGridProperties.handleADDREGRecords( records , regionProperty, m_threads );
            else if (m_doubleGridProperties.supportsKeyword( targetArray ))
-               m_doubleGridProperties.handleADDREGRecord( record , regionProperty );
+               m_doubleGridProperties.handleADDREGRecords( records , regionProperty, m_threads );
            else
                throw std::invalid_argument("Fatal error processing ADDREG keyword - invalid/undefined keyword: " + targetArray);
        }
@@ -844,14 +947,14 @@ namespace Opm {
 
 
     void Eclipse3DProperties::handleMULTIREGKeyword( const DeckKeyword& deckKeyword) {
-        for( const auto& record : deckKeyword ) {
-            const std::string& targetArray = record.getItem("ARRAY").get< std::string >(0);
-            const auto& regionProperty = getRegion( record.getItem("REGION_NAME") );
+        for( const auto& records : groupRegionRecords( deckKeyword ) ) {
+            const std::string& targetArray = records.front()->getItem("ARRAY").get< std::string >(0);
+            const auto& regionProperty = getRegion( records.front()->getItem("REGION_NAME") );
 
            if (m_intGridProperties.supportsKeyword( targetArray ))
-               m_intGridProperties.handleMULTIREGRecord( record , regionProperty );
+               m_intGridProperties.handleMULTIREGRecords( records , regionProperty, m_threads );
            else if (m_doubleGridProperties.supportsKeyword( targetArray ))
-               m_doubleGridProperties.handleMULTIREGRecord( record , regionProperty );
+               m_doubleGridProperties.handleMULTIREGRecords( records , regionProperty, m_threads );
            else
                throw std::invalid_argument("Fatal error processing MULTIREG keyword - invalid/undefined keyword: " + targetArray);
         }
@@ -859,14 +962,14 @@ namespace Opm {
 
 
     void Eclipse3DProperties::handleCOPYREGKeyword( const DeckKeyword& deckKeyword) {
-        for( const auto& record : deckKeyword ) {
-            const std::string& srcArray = record.getItem("ARRAY").get< std::string >(0);
-            const auto& regionProperty = getRegion( record.getItem("REGION_NAME") );
+        for( const auto& records : groupRegionRecords( deckKeyword ) ) {
+            const std::string& srcArray = records.front()->getItem("ARRAY").get< std::string >(0);
+            const auto& regionProperty = getRegion( records.front()->getItem("REGION_NAME") );
 
             if (m_intGridProperties.hasKeyword( srcArray ))
-                m_intGridProperties.handleCOPYREGRecord( record, regionProperty );
+                m_intGridProperties.handleCOPYREGRecords( records, regionProperty, m_threads );
             else if (m_doubleGridProperties.hasKeyword( srcArray ))
-                m_doubleGridProperties.handleCOPYREGRecord( record, regionProperty );
+                m_doubleGridProperties.handleCOPYREGRecords( records, regionProperty, m_threads );
             else
                 throw std::invalid_argument("Fatal error processing COPYREG keyword - invalid/undefined keyword: " + srcArray);
         }
@@ -17,7 +17,9 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <future>
 #include <set>
+#include <type_traits>
 
 #include <boost/algorithm/string/join.hpp>
 
@@ -48,15 +50,110 @@
 
 namespace Opm {
 
-    EclipseState::EclipseState(const Deck& deck, ParseContext parseContext) :
+namespace {
+
+    template< typename F >
+    std::future< typename std::result_of< F() >::type >
+    launch( size_t threads, F f ) {
+        const auto policy = threads > 1 ? std::launch::async
+                                        : std::launch::deferred;
+        return std::async( policy, std::move( f ) );
+    }
+
+    void setMULTFLT( FaultCollection& faults, const Section& section ) {
+        for (size_t index=0; index < section.count("MULTFLT"); index++) {
+            const auto& faultsKeyword = section.getKeyword("MULTFLT" , index);
+            for (auto iter = faultsKeyword.begin(); iter != faultsKeyword.end(); ++iter) {
+
+                const auto& faultRecord = *iter;
+                const std::string& faultName = faultRecord.getItem(0).get< std::string >(0);
+                double multFlt = faultRecord.getItem(1).get< double >(0);
+
+                faults.setTransMult( faultName , multFlt );
+            }
+        }
+    }
+
+    /*
+      The components read the SI data of the deck items concurrently,
+      which is only a pure read once an item is converted. The parser
+      converts every item, but a deck assembled or modified by hand may
+      still have items which would be converted lazily on first use.
+    */
+    const Deck& convertToSI( const Deck& deck, size_t threads ) {
+        if (threads > 1) {
+            for (const auto& keyword : deck)
+                for (const auto& record : keyword)
+                    for (const auto& item : record)
+                        item.convertToSI();
+        }
+
+        return deck;
+    }
+
+    FaultCollection makeFaults( const Deck& deck ) {
+        const GRIDSection gridSection ( deck );
+
+        FaultCollection faults( gridSection, GridDims( deck ) );
+        setMULTFLT( faults, gridSection );
+
+        if (Section::hasEDIT(deck)) {
+            setMULTFLT( faults, EDITSection ( deck ) );
+        }
+
+        return faults;
+    }
+
+}
+
+    /*
+     * The components of the EclipseState which only depend on the deck.
+     * They are launched before the members are initialized, and the
+     * dependencies between the components are then
+     *
+     *   grid, tables, runspec, config, NNC, faults  <-  deck
+     *   grid properties                             <-  grid, tables
+     *   simulation config, transmissibility mult.   <-  grid properties
+     *
+     * so that with threads > 1 the construction takes roughly as long as
+     * the grid and the grid properties. With threads == 1 the components
+     * are deferred, and built in order on the calling thread.
+     *
+     * The concurrent construction requires every double item of the deck
+     * to be converted to SI units, so that reading the SI data does not
+     * write to the items; with threads > 1 the deck is converted on the
+     * calling thread before the components are launched, see
+     * convertToSI().
+     */
+    struct EclipseState::Components {
+        Components( const Deck& deck, size_t threads ) :
+            tables(  launch( threads, [&deck] { return TableManager( deck ); } ) ),
+            runspec( launch( threads, [&deck] { return Runspec( deck ); } ) ),
+            config(  launch( threads, [&deck] { return EclipseConfig( deck ); } ) ),
+            nnc(     launch( threads, [&deck] { return NNC( deck ); } ) ),
+            faults(  launch( threads, [&deck] { return makeFaults( deck ); } ) )
+        {}
+
+        std::future< TableManager > tables;
+        std::future< Runspec > runspec;
+        std::future< EclipseConfig > config;
+        std::future< NNC > nnc;
+        std::future< FaultCollection > faults;
+    };
+
+    EclipseState::EclipseState(const Deck& deck, ParseContext parseContext, size_t threads) :
+        EclipseState( deck, std::move( parseContext ), threads, Components( convertToSI( deck, threads ), threads ) )
+    {}
+
+    EclipseState::EclipseState(const Deck& deck, ParseContext parseContext, size_t threads, Components&& components) :
         m_parseContext(      parseContext ),
-        m_tables(            deck ),
-        m_runspec(           deck ),
-        m_eclipseConfig(     deck ),
         m_deckUnitSystem(    deck.getActiveUnitSystem() ),
-        m_inputNnc(          deck ),
         m_inputGrid(         deck, nullptr ),
-        m_eclipseProperties( deck, m_tables, m_inputGrid ),
+        m_tables(            components.tables.get() ),
+        m_runspec(           components.runspec.get() ),
+        m_eclipseConfig(     components.config.get() ),
+        m_inputNnc(          components.nnc.get() ),
+        m_eclipseProperties( deck, m_tables, m_inputGrid, threads ),
         m_simulationConfig(  deck, m_eclipseProperties ),
         m_transMult(         GridDims(deck), deck, m_eclipseProperties )
     {
@@ -74,7 +171,7 @@ namespace Opm {
         }
 
         initTransMult();
-        initFaults(deck);
+        initFaults( components.faults.get() );
 
         m_messageContainer.appendMessages(m_tables.getMessageContainer());
         m_messageContainer.appendMessages(m_inputGrid.getMessageContainer());
@@ -110,6 +207,10 @@ namespace Opm {
         return m_eclipseProperties;
     }
 
+    void EclipseState::compressGridProperties() {
+        m_eclipseProperties.compress( m_inputGrid );
+    }
+
     const MessageContainer& EclipseState::getMessageContainer() const {
         return m_messageContainer;
     }
@@ -194,35 +295,13 @@ namespace Opm {
             m_transMult.applyMULT(p.getDoubleGridProperty("MULTZ-"), FaceDir::ZMinus);
     }
 
-    void EclipseState::initFaults(const Deck& deck) {
-        const GRIDSection gridSection ( deck );
-
-        m_faults = FaultCollection(gridSection, m_inputGrid);
-        setMULTFLT(gridSection);
-
-        if (Section::hasEDIT(deck)) {
-            setMULTFLT(EDITSection ( deck ));
-        }
-
+    void EclipseState::initFaults(FaultCollection faults) {
+        m_faults = std::move( faults );
         m_transMult.applyMULTFLT( m_faults );
     }
 
 
 
-    void EclipseState::setMULTFLT(const Section& section) {
-        for (size_t index=0; index < section.count("MULTFLT"); index++) {
-            const auto& faultsKeyword = section.getKeyword("MULTFLT" , index);
-            for (auto iter = faultsKeyword.begin(); iter != faultsKeyword.end(); ++iter) {
-
-                const auto& faultRecord = *iter;
-                const std::string& faultName = faultRecord.getItem(0).get< std::string >(0);
-                double multFlt = faultRecord.getItem(1).get< double >(0);
-
-                m_faults.setTransMult( faultName , multFlt );
-            }
-        }
-    }
-
     void EclipseState::complainAboutAmbiguousKeyword(const Deck& deck, const std::string& keywordName) {
         m_messageContainer.error("The " + keywordName + " keyword must be unique in the deck. Ignoring all!");
         auto keywords = deck.getKeywordList(keywordName);
@@ -47,6 +47,8 @@
 
 #include <ert/ecl/ecl_grid.h>
 
+#include "parallel_for.hpp"
+
 namespace Opm {
 
 
@@ -845,6 +847,63 @@ namespace Opm {
     }
 
 
+    const std::array< std::vector<double>, 3 >& EclipseGrid::getCellCenters(size_t threads) const {
+        return this->cellCenters.get( [this,threads]( std::array< std::vector<double>, 3 >& centers ) {
+            const size_t size = this->getCartesianSize();
+            for (auto& dim : centers)
+                dim.resize( size );
+
+            parallel_for( size, threads, [&]( size_t begin, size_t end ) {
+                for (size_t g = begin; g < end; g++)
+                    ecl_grid_get_xyz1( c_ptr() , static_cast<int>(g) ,
+                                       &centers[0][g] , &centers[1][g] , &centers[2][g] );
+            });
+        });
+    }
+
+
+    const std::vector<double>& EclipseGrid::getCellDepths(size_t threads) const {
+        return this->cellDepths.get( [this,threads]( std::vector<double>& depths ) {
+            depths.resize( this->getCartesianSize() );
+
+            parallel_for( depths.size(), threads, [&]( size_t begin, size_t end ) {
+                for (size_t g = begin; g < end; g++)
+                    depths[g] = ecl_grid_get_cdepth1( c_ptr() , static_cast<int>(g) );
+            });
+        });
+    }
+
+
+    const std::vector<double>& EclipseGrid::getCellVolumes(size_t threads) const {
+        return this->cellVolumes.get( [this,threads]( std::vector<double>& volumes ) {
+            volumes.resize( this->getCartesianSize() );
+
+            parallel_for( volumes.size(), threads, [&]( size_t begin, size_t end ) {
+                for (size_t g = begin; g < end; g++)
+                    volumes[g] = ecl_grid_get_cell_volume1( c_ptr() , static_cast<int>(g) );
+            });
+        });
+    }
+
+
+    const std::array< std::vector<double>, 3 >& EclipseGrid::getCellDimensions(size_t threads) const {
+        return this->cellDimensions.get( [this,threads]( std::array< std::vector<double>, 3 >& dims ) {
+            const size_t size = this->getCartesianSize();
+            for (auto& dim : dims)
+                dim.resize( size );
+
+            parallel_for( size, threads, [&]( size_t begin, size_t end ) {
+                for (size_t g = begin; g < end; g++) {
+                    const int index = static_cast<int>( g );
+                    dims[0][g] = ecl_grid_get_cell_dx1( c_ptr() , index );
+                    dims[1][g] = ecl_grid_get_cell_dy1( c_ptr() , index );
+                    dims[2][g] = ecl_grid_get_cell_thickness1( c_ptr() , index );
+                }
+            });
+        });
+    }
+
+
 
     void EclipseGrid::exportACTNUM( std::vector<int>& actnum) const {
         size_t volume = getNX() * getNY() * getNZ();
@@ -881,27 +940,44 @@ namespace Opm {
 
 
 
-    const std::vector<int>& EclipseGrid::getActiveMap() const {
-        if( !this->activeMap.empty() ) return this->activeMap;
-
-        this->activeMap.resize( this->getNumActive() );
-        const auto size = int(this->getCartesianSize());
+    void EclipseGrid::exportCellGeometry( std::vector<double>& volume,
+                                          std::vector<double>& depth,
+                                          std::vector<double>& thickness,
+                                          size_t threads ) const {
+        const size_t size = this->getCartesianSize();
+        volume.resize( size );
+        depth.resize( size );
+        thickness.resize( size );
 
-        for( int global_index = 0; global_index < size; global_index++) {
-            // Using the low level C function to get the active index, because the C++
-            // version will throw for inactive cells.
-            int active_index = ecl_grid_get_active_index1( m_grid.get() , global_index );
-            if (active_index >= 0)
-                this->activeMap[ active_index ] = global_index;
-        }
+        parallel_for( size, threads, [&]( size_t begin, size_t end ) {
+            for (size_t g = begin; g < end; g++) {
+                const int index = static_cast<int>( g );
+                volume[g] = ecl_grid_get_cell_volume1( c_ptr() , index );
+                depth[g] = ecl_grid_get_cdepth1( c_ptr() , index );
+                thickness[g] = ecl_grid_get_cell_thickness1( c_ptr() , index );
+            }
+        });
+    }
 
-        return this->activeMap;
+    const std::vector<int>& EclipseGrid::getActiveMap() const {
+        return this->activeMap.get( [this]( std::vector<int>& activeMap ) {
+            activeMap.resize( this->getNumActive() );
+            const auto size = int(this->getCartesianSize());
+
+            for( int global_index = 0; global_index < size; global_index++) {
+                // Using the low level C function to get the active index, because the C++
+                // version will throw for inactive cells.
+                int active_index = ecl_grid_get_active_index1( m_grid.get() , global_index );
+                if (active_index >= 0)
+                    activeMap[ active_index ] = global_index;
+            }
+        });
     }
 
     void EclipseGrid::resetACTNUM( const int * actnum) {
         ecl_grid_reset_actnum( m_grid.get() , actnum );
         /* re-build the active map cache */
-        this->activeMap.clear();
+        this->activeMap.reset();
         this->getActiveMap();
     }
 
@@ -18,11 +18,15 @@
 */
 
 #include <cmath>
+#include <cstdint>
+#include <map>
 
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperties.hpp>
 #include <opm/parser/eclipse/Utility/String.hpp>
 
+#include "parallel_for.hpp"
+
 namespace Opm {
 
     /*
@@ -196,8 +200,29 @@ namespace Opm {
 
     template< typename T >
     void GridProperties<T>::insertKeyword(const SupportedKeywordInfo& supportedKeyword) const {
-        m_properties.emplace( supportedKeyword.getKeywordName(), 
-                GridProperty<T>( this->nx, this->ny , this->nz , supportedKeyword ));
+        auto iter = m_properties.emplace( supportedKeyword.getKeywordName(),
+                GridProperty<T>( this->nx, this->ny , this->nz , supportedKeyword )).first;
+
+        if (m_activeIndex)
+            iter->second.compress( m_activeIndex );
+    }
+
+
+    template< typename T >
+    void GridProperties<T>::compress( std::shared_ptr< const std::vector< int > > activeIndex ) {
+        if (m_activeIndex)
+            throw std::logic_error("The grid properties are already compressed");
+
+        for (auto& pair : m_properties)
+            pair.second.compress( activeIndex );
+
+        m_activeIndex = std::move( activeIndex );
+    }
+
+
+    template< typename T >
+    bool GridProperties<T>::isCompressed() const {
+        return bool( m_activeIndex );
     }
 
 
@@ -339,56 +364,131 @@ namespace Opm {
     }
 
 
+    /*
+      The values the region keywords work on: all the cells of an
+      uncompressed property, or the active cells of a compressed one.
+      The properties of a grid are compressed together, so a property
+      and its region array are indexed the same way.
+    */
     template< typename T >
-    void GridProperties<T>::handleEQUALREGRecord( const DeckRecord& record, const GridProperty<int>& regionProperty ) {
-        const std::string& targetArray = record.getItem("ARRAY").get< std::string >(0);
-        if (supportsKeyword( targetArray )) {
-            GridProperty<T>& targetProperty = getOrCreateProperty( targetArray  );
-            double inputValue = record.getItem("VALUE").get<double>(0);
-            int regionValue = record.getItem("REGION_NUMBER").get<int>(0);
-            T targetValue = convertInputValue( targetProperty , inputValue );
-            std::vector<bool> mask;
-
-            regionProperty.initMask( regionValue , mask);
-            targetProperty.maskedSet( targetValue , mask);
-        } else
+    static std::vector< T >& cellData( GridProperty< T >& property,
+                                       const GridProperty< int >& regionProperty ) {
+        if( property.isCompressed() != regionProperty.isCompressed() )
+            throw std::logic_error("The property " + property.getKeywordName()
+                                   + " and the region array " + regionProperty.getKeywordName()
+                                   + " are not stored for the same cells");
+
+        return property.isCompressed() ? property.getCompressedData() : property.getData();
+    }
+
+    /*
+      Apply a table of region value -> action to the cells of a grid, as
+      apply( index, action ) with index into cellData(), split over up
+      to threads threads; apply must only touch the cell it is given.
+      The table is made dense over its range of region values unless
+      that range is unreasonably large.
+    */
+    template< typename A, typename F >
+    static void applyRegionTable( const std::map< int, A >& table,
+                                  const GridProperty< int >& regionProperty,
+                                  size_t threads,
+                                  F apply ) {
+        if( table.empty() ) return;
+
+        const auto& regions = regionProperty.isCompressed() ? regionProperty.getCompressedData()
+                                                            : regionProperty.getData();
+        const int64_t lo = table.begin()->first;
+        const int64_t hi = table.rbegin()->first;
+
+        if( hi - lo >= (int64_t( 1 ) << 20) ) {
+            parallel_for( regions.size(), threads, [&]( size_t begin, size_t end ) {
+                for( size_t g = begin; g < end; ++g ) {
+                    const auto action = table.find( regions[ g ] );
+                    if( action != table.end() ) apply( g, action->second );
+                }
+            });
+            return;
+        }
+
+        std::vector< const A* > dense( hi - lo + 1, nullptr );
+        for( const auto& action : table )
+            dense[ action.first - lo ] = &action.second;
+
+        parallel_for( regions.size(), threads, [&]( size_t begin, size_t end ) {
+            for( size_t g = begin; g < end; ++g ) {
+                const int64_t region = regions[ g ];
+                if( region < lo || region > hi ) continue;
+
+                const auto* action = dense[ region - lo ];
+                if( action ) apply( g, *action );
+            }
+        });
+    }
+
+    template< typename T >
+    void GridProperties<T>::handleEQUALREGRecords( const RecordGroup& records, const GridProperty<int>& regionProperty, size_t threads ) {
+        const std::string& targetArray = records.front()->getItem("ARRAY").get< std::string >(0);
+        if (!supportsKeyword( targetArray ))
             throw std::invalid_argument("Fatal error processing EQUALREG record - invalid/undefined keyword: " + targetArray);
+
+        GridProperty<T>& targetProperty = getOrCreateProperty( targetArray  );
+        std::map< int, T > values;
+        for (const auto* record : records) {
+            double inputValue = record->getItem("VALUE").get<double>(0);
+            int regionValue = record->getItem("REGION_NUMBER").get<int>(0);
+            values[ regionValue ] = convertInputValue( targetProperty , inputValue );
+        }
+
+        auto& data = cellData( targetProperty, regionProperty );
+        applyRegionTable( values, regionProperty, threads, [&data]( size_t g, T value ) {
+            data[ g ] = value;
+        });
     }
 
     template< typename T >
-    void GridProperties<T>::handleADDREGRecord( const DeckRecord& record, const GridProperty<int>& regionProperty ) {
-        const std::string& targetArray = record.getItem("ARRAY").get< std::string >(0);
+    void GridProperties<T>::handleADDREGRecords( const RecordGroup& records, const GridProperty<int>& regionProperty, size_t threads ) {
+        const std::string& targetArray = records.front()->getItem("ARRAY").get< std::string >(0);
         assertKeyword(targetArray);
 
         GridProperty<T>& targetProperty = getKeyword( targetArray  );
-        double inputValue = record.getItem("SHIFT").get<double>(0);
-        int regionValue = record.getItem("REGION_NUMBER").get<int>(0);
-        T shiftValue = convertInputValue( targetProperty , inputValue );
-        std::vector<bool> mask;
+        std::map< int, std::vector< T > > shifts;
+        for (const auto* record : records) {
+            double inputValue = record->getItem("SHIFT").get<double>(0);
+            int regionValue = record->getItem("REGION_NUMBER").get<int>(0);
+            shifts[ regionValue ].push_back( convertInputValue( targetProperty , inputValue ) );
+        }
 
-        regionProperty.initMask( regionValue , mask);
-        targetProperty.maskedAdd( shiftValue , mask);
+        auto& data = cellData( targetProperty, regionProperty );
+        applyRegionTable( shifts, regionProperty, threads, [&data]( size_t g, const std::vector< T >& cellShifts ) {
+            for (const auto shift : cellShifts)
+                data[ g ] += shift;
+        });
     }
 
     template< typename T >
-    void GridProperties<T>::handleMULTIREGRecord( const DeckRecord& record, const GridProperty<int>& regionProperty ) {
-        const std::string& targetArray = record.getItem("ARRAY").get< std::string >(0);
+    void GridProperties<T>::handleMULTIREGRecords( const RecordGroup& records, const GridProperty<int>& regionProperty, size_t threads ) {
+        const std::string& targetArray = records.front()->getItem("ARRAY").get< std::string >(0);
         assertKeyword( targetArray );
 
         GridProperty<T>& targetProperty = getOrCreateProperty( targetArray  );
-        double inputValue = record.getItem("FACTOR").get<double>(0);
-        int regionValue = record.getItem("REGION_NUMBER").get<int>(0);
-        T factor = convertInputValue( inputValue );
-        std::vector<bool> mask;
+        std::map< int, std::vector< T > > factors;
+        for (const auto* record : records) {
+            double inputValue = record->getItem("FACTOR").get<double>(0);
+            int regionValue = record->getItem("REGION_NUMBER").get<int>(0);
+            factors[ regionValue ].push_back( convertInputValue( inputValue ) );
+        }
 
-        regionProperty.initMask( regionValue , mask);
-        targetProperty.maskedMultiply( factor , mask);
+        auto& data = cellData( targetProperty, regionProperty );
+        applyRegionTable( factors, regionProperty, threads, [&data]( size_t g, const std::vector< T >& cellFactors ) {
+            for (const auto factor : cellFactors)
+                data[ g ] *= factor;
+        });
     }
 
     template< typename T >
-    void GridProperties<T>::handleCOPYREGRecord( const DeckRecord& record, const GridProperty<int>& regionProperty ) {
-        const std::string& srcArray    = record.getItem("ARRAY").get< std::string >(0);
-        const std::string& targetArray = record.getItem("TARGET_ARRAY").get< std::string >(0);
+    void GridProperties<T>::handleCOPYREGRecords( const RecordGroup& records, const GridProperty<int>& regionProperty, size_t threads ) {
+        const std::string& srcArray    = records.front()->getItem("ARRAY").get< std::string >(0);
+        const std::string& targetArray = records.front()->getItem("TARGET_ARRAY").get< std::string >(0);
 
         if (!supportsKeyword( targetArray))
             throw std::invalid_argument("Fatal error processing COPYREG record - invalid/undefined keyword: " + targetArray);
@@ -397,13 +497,18 @@ namespace Opm {
             throw std::invalid_argument("Fatal error processing COPYREG record - invalid/undefined keyword: " + srcArray);
 
         {
-            int regionValue = record.getItem("REGION_NUMBER").get< int >(0);
-            std::vector<bool> mask;
+            std::map< int, bool > copy;
+            for (const auto* record : records)
+                copy[ record->getItem("REGION_NUMBER").get< int >(0) ] = true;
+
             GridProperty<T>& targetProperty = getOrCreateProperty( targetArray );
             GridProperty<T>& srcProperty = getKeyword( srcArray );
 
-            regionProperty.initMask( regionValue , mask);
-            targetProperty.maskedCopy( srcProperty , mask );
+            auto& data = cellData( targetProperty, regionProperty );
+            const auto& src = cellData( srcProperty, regionProperty );
+            applyRegionTable( copy, regionProperty, threads, [&data, &src]( size_t g, bool ) {
+                data[ g ] = src[ g ];
+            });
         }
     }
 
@@ -18,6 +18,7 @@
 */
 
 #include <limits>
+#include <map>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -134,7 +135,7 @@ namespace Opm {
 
     template< typename T >
     size_t GridProperty< T >::getCartesianSize() const {
-        return m_data.size();
+        return m_nx * m_ny * m_nz;
     }
 
     template< typename T >
@@ -154,6 +155,11 @@ namespace Opm {
 
     template< typename T >
     T GridProperty< T >::iget( size_t index ) const {
+        if (this->m_activeIndex) {
+            const int activeIndex = this->m_activeIndex->at( index );
+            return activeIndex < 0 ? T( 0 ) : this->m_data[ activeIndex ];
+        }
+
         return this->m_data.at( index );
     }
 
@@ -165,6 +171,15 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::iset(size_t index, T value) {
+        if (this->m_activeIndex) {
+            const int activeIndex = this->m_activeIndex->at( index );
+            if (activeIndex < 0)
+                throw std::invalid_argument("Can not set the value of an inactive cell in the compressed property " + getKeywordName());
+
+            this->m_data[ activeIndex ] = value;
+            return;
+        }
+
         this->m_data.at( index ) = value;
     }
 
@@ -176,17 +191,21 @@ namespace Opm {
 
     template< typename T >
     const std::vector< T >& GridProperty< T >::getData() const {
+        assertUncompressed( "getData" );
         return m_data;
     }
 
 
     template< typename T >
     std::vector< T >& GridProperty< T >::getData() {
+        assertUncompressed( "getData" );
         return m_data;
     }
 
     template< typename T >
     void GridProperty< T >::multiplyWith( const GridProperty< T >& other ) {
+        assertUncompressed( "multiplyWith" );
+        other.assertUncompressed( "multiplyWith" );
         if ((m_nx == other.m_nx) && (m_ny == other.m_ny) && (m_nz == other.m_nz)) {
             for (size_t g=0; g < m_data.size(); g++)
                 m_data[g] *= other.m_data[g];
@@ -196,6 +215,7 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::multiplyValueAtIndex(size_t index, T factor) {
+        assertUncompressed( "multiplyValueAtIndex" );
         m_data[index] *= factor;
     }
 
@@ -203,6 +223,7 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::maskedSet( T value, const std::vector< bool >& mask ) {
+        assertUncompressed( "maskedSet" );
         for (size_t g = 0; g < getCartesianSize(); g++) {
             if (mask[g])
                 m_data[g] = value;
@@ -211,6 +232,7 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::maskedMultiply( T value, const std::vector<bool>& mask ) {
+        assertUncompressed( "maskedMultiply" );
         for (size_t g = 0; g < getCartesianSize(); g++) {
             if (mask[g])
                 m_data[g] *= value;
@@ -220,6 +242,7 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::maskedAdd( T value, const std::vector<bool>& mask ) {
+        assertUncompressed( "maskedAdd" );
         for (size_t g = 0; g < getCartesianSize(); g++) {
             if (mask[g])
                 m_data[g] += value;
@@ -228,6 +251,8 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::maskedCopy( const GridProperty< T >& other, const std::vector< bool >& mask) {
+        assertUncompressed( "maskedCopy" );
+        other.assertUncompressed( "maskedCopy" );
         for (size_t g = 0; g < getCartesianSize(); g++) {
             if (mask[g])
                 m_data[g] = other.m_data[g];
@@ -236,6 +261,7 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::initMask( T value, std::vector< bool >& mask ) const {
+        assertUncompressed( "initMask" );
         mask.resize(getCartesianSize());
         for (size_t g = 0; g < getCartesianSize(); g++) {
             if (m_data[g] == value)
@@ -247,6 +273,7 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::loadFromDeckKeyword( const DeckKeyword& deckKeyword ) {
+        assertUncompressed( "loadFromDeckKeyword" );
         const auto& deckItem = getDeckItem(deckKeyword);
         const auto size = deckItem.size();
         for (size_t dataPointIdx = 0; dataPointIdx < size; ++dataPointIdx) {
@@ -257,6 +284,7 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::loadFromDeckKeyword( const Box& inputBox, const DeckKeyword& deckKeyword) {
+        assertUncompressed( "loadFromDeckKeyword" );
         if (inputBox.isGlobal())
             loadFromDeckKeyword( deckKeyword );
         else {
@@ -282,6 +310,8 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::copyFrom( const GridProperty< T >& src, const Box& inputBox ) {
+        assertUncompressed( "copyFrom" );
+        src.assertUncompressed( "copyFrom" );
         if (inputBox.isGlobal()) {
             for (size_t i = 0; i < src.getCartesianSize(); ++i)
                 m_data[i] = src.m_data[i];
@@ -296,6 +326,7 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::maxvalue( T value, const Box& inputBox ) {
+        assertUncompressed( "maxvalue" );
         if (inputBox.isGlobal()) {
             for (size_t i = 0; i < m_data.size(); ++i)
                 m_data[i] = std::min(value,m_data[i]);
@@ -310,6 +341,7 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::minvalue( T value, const Box& inputBox ) {
+        assertUncompressed( "minvalue" );
         if (inputBox.isGlobal()) {
             for (size_t i = 0; i < m_data.size(); ++i)
                 m_data[i] = std::max(value,m_data[i]);
@@ -324,6 +356,7 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::scale( T scaleFactor, const Box& inputBox ) {
+        assertUncompressed( "scale" );
         if (inputBox.isGlobal()) {
             for (size_t i = 0; i < m_data.size(); ++i)
                 m_data[i] *= scaleFactor;
@@ -338,6 +371,7 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::add( T shiftValue, const Box& inputBox ) {
+        assertUncompressed( "add" );
         if (inputBox.isGlobal()) {
             for (size_t i = 0; i < m_data.size(); ++i)
                 m_data[i] += shiftValue;
@@ -352,6 +386,7 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::setScalar( T value, const Box& inputBox ) {
+        assertUncompressed( "setScalar" );
         if (inputBox.isGlobal()) {
             std::fill(m_data.begin(), m_data.end(), value);
         } else {
@@ -381,6 +416,62 @@ namespace Opm {
         this->m_kwInfo.postProcessor()( m_data );
     }
 
+    template< typename T >
+    void GridProperty< T >::compress( std::shared_ptr< const std::vector< int > > activeIndex ) {
+        if (this->m_activeIndex)
+            throw std::logic_error("The property " + getKeywordName() + " is already compressed");
+
+        if (activeIndex->size() != getCartesianSize())
+            throw std::invalid_argument("Size mismatch when compressing " + getKeywordName());
+
+        this->runPostProcessor();
+
+        std::vector< T > activeData;
+        for (size_t g = 0; g < activeIndex->size(); g++) {
+            if ((*activeIndex)[g] >= 0)
+                activeData.push_back( m_data[g] );
+        }
+
+        activeData.shrink_to_fit();
+        this->m_data.swap( activeData );
+        this->m_activeIndex = std::move( activeIndex );
+    }
+
+    template< typename T >
+    bool GridProperty< T >::isCompressed() const {
+        return bool( this->m_activeIndex );
+    }
+
+    template< typename T >
+    const std::vector< T >& GridProperty< T >::getCompressedData() const {
+        if (!this->m_activeIndex)
+            throw std::logic_error("The property " + getKeywordName() + " is not compressed");
+
+        return m_data;
+    }
+
+    template< typename T >
+    std::vector< T >& GridProperty< T >::getCompressedData() {
+        if (!this->m_activeIndex)
+            throw std::logic_error("The property " + getKeywordName() + " is not compressed");
+
+        return m_data;
+    }
+
+    template< typename T >
+    const std::vector< int >& GridProperty< T >::getActiveIndex() const {
+        if (!this->m_activeIndex)
+            throw std::logic_error("The property " + getKeywordName() + " is not compressed");
+
+        return *this->m_activeIndex;
+    }
+
+    template< typename T >
+    void GridProperty< T >::assertUncompressed( const std::string& method ) const {
+        if (this->m_activeIndex)
+            throw std::logic_error("GridProperty::" + method + "() is not available for the compressed property " + getKeywordName());
+    }
+
     template< typename T >
     void GridProperty< T >::checkLimits( T min, T max ) const {
         for (size_t g=0; g < m_data.size(); g++) {
@@ -457,6 +548,13 @@ const std::string& GridProperty<double>::getDimensionString() const {
 
 template<typename T>
 std::vector<T> GridProperty<T>::compressedCopy(const EclipseGrid& grid) const {
+    if (m_activeIndex) {
+        if (grid.getNumActive() != m_data.size())
+            throw std::invalid_argument("The grid does not match the active cells of the compressed property " + getKeywordName());
+
+        return m_data;
+    }
+
     if (grid.allActive())
         return m_data;
     else {
@@ -469,6 +567,17 @@ std::vector<T> GridProperty<T>::compressedCopy(const EclipseGrid& grid) const {
 template<typename T>
 std::vector<size_t> GridProperty<T>::cellsEqual(T value, const std::vector<int>& activeMap) const {
     std::vector<size_t> cells;
+    if (m_activeIndex) {
+        if (activeMap.size() != m_data.size())
+            throw std::invalid_argument("The active map does not match the active cells of the compressed property " + getKeywordName());
+
+        for (size_t active_index = 0; active_index < m_data.size(); active_index++) {
+            if (m_data[active_index] == value)
+                cells.push_back( active_index );
+        }
+        return cells;
+    }
+
     for (size_t active_index = 0; active_index < activeMap.size(); active_index++) {
         size_t global_index = activeMap[ active_index ];
         if (m_data[global_index] == value)
@@ -481,6 +590,14 @@ std::vector<size_t> GridProperty<T>::cellsEqual(T value, const std::vector<int>&
 template<typename T>
 std::vector<size_t> GridProperty<T>::indexEqual(T value) const {
     std::vector<size_t> index_list;
+    if (m_activeIndex) {
+        for (size_t index = 0; index < m_activeIndex->size(); index++) {
+            if (iget( index ) == value)
+                index_list.push_back( index );
+        }
+        return index_list;
+    }
+
     for (size_t index = 0; index < m_data.size(); index++) {
         if (m_data[index] == value)
             index_list.push_back( index );
@@ -503,16 +620,37 @@ std::vector< double > temperature_lookup( size_t size,
                                           const GridProperties<int>* ig_props ) {
 
     if (tables->hasTables("RTEMPVD")) {
-        const std::vector< int >& eqlNum = ig_props->getKeyword("EQLNUM").getData();
+        const auto& eqlNum = ig_props->getKeyword("EQLNUM");
 
         const auto& rtempvdTables = tables->getRtempvdTables();
+        const auto& cellDepths = grid->getCellCenters()[2];
         std::vector< double > values( size, 0 );
 
-        for (size_t cellIdx = 0; cellIdx < eqlNum.size(); ++ cellIdx) {
-            int cellEquilRegionIdx = eqlNum[cellIdx] - 1; // EQLNUM contains fortran-style indices!
-            const RtempvdTable& rtempvdTable = rtempvdTables.getTable<RtempvdTable>(cellEquilRegionIdx);
-            double cellDepth = std::get<2>(grid->getCellCenter(cellIdx));
-            values[cellIdx] = rtempvdTable.evaluate("Temperature", cellDepth);
+        /*
+         * Gather the cells of every equilibration region and evaluate
+         * each region's table once for all its cell depths.
+         */
+        std::map< int, std::vector< size_t > > regionCells;
+        for (size_t cellIdx = 0; cellIdx < size; ++ cellIdx) {
+            // the inactive cells of a compressed EQLNUM have no region
+            if (eqlNum.isCompressed() && !grid->cellActive(cellIdx))
+                continue;
+
+            regionCells[ eqlNum.iget(cellIdx) - 1 ].push_back( cellIdx ); // EQLNUM contains fortran-style indices!
+        }
+
+        for (const auto& region : regionCells) {
+            const RtempvdTable& rtempvdTable = rtempvdTables.getTable<RtempvdTable>(region.first);
+            const auto& cells = region.second;
+
+            std::vector< double > depths;
+            depths.reserve( cells.size() );
+            for (const auto cellIdx : cells)
+                depths.push_back( cellDepths[ cellIdx ] );
+
+            const auto temperatures = rtempvdTable.evaluate( "Temperature", depths );
+            for (size_t i = 0; i < cells.size(); ++i)
+                values[ cells[ i ] ] = temperatures[ i ];
         }
 
         return values;
@@ -17,6 +17,7 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <stdexcept>
 #include <map>
 #include <set>
@@ -26,8 +27,12 @@
 #include <opm/parser/eclipse/Deck/DeckRecord.hpp>
 #include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/FaceDir.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridDims.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/MULTREGTScanner.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/NNC.hpp>
+
+#include "parallel_for.hpp"
 
 namespace Opm {
 
@@ -153,18 +158,63 @@ namespace Opm {
                               + " which is not in the deck");
         }
 
+        std::map<std::string , MULTREGTSearchMap> searchMap;
         for (auto iter = searchPairs.begin(); iter != searchPairs.end(); ++iter) {
             const MULTREGTRecord * record = (*iter).second;
             std::pair<int,int> pair = (*iter).first;
             const std::string& keyword = record->m_region.getValue();
-            if (m_searchMap.count(keyword) == 0)
-                m_searchMap[keyword] = MULTREGTSearchMap();
+            searchMap[keyword][pair] = record;
+        }
+
+        for (const auto& keywordMap : searchMap) {
+            RegionTable table;
+            table.keyword = keywordMap.first;
+
+            for (const auto& pair : keywordMap.second) {
+                for (int region : { pair.first.first, pair.first.second }) {
+                    if (region >= 0)
+                        table.regions.push_back( region );
+                }
+            }
+
+            std::sort( table.regions.begin(), table.regions.end() );
+            table.regions.erase( std::unique( table.regions.begin(), table.regions.end() ),
+                                 table.regions.end() );
+
+            const size_t size = table.regions.size();
+            table.records.assign( size * size, -1 );
+            for (const auto& pair : keywordMap.second) {
+                const auto src = table.index( pair.first.first );
+                const auto target = table.index( pair.first.second );
+                if (src < 0 || target < 0) continue;
 
-            m_searchMap[keyword][pair] = record;
+                table.records[ src * size + target ] = pair.second - m_records.data();
+            }
+
+            m_regionTables.push_back( std::move( table ) );
         }
     }
 
 
+    int MULTREGTScanner::RegionTable::index(int region) const {
+        const auto iter = std::lower_bound( this->regions.begin(), this->regions.end(), region );
+        if (iter == this->regions.end() || *iter != region) return -1;
+
+        return iter - this->regions.begin();
+    }
+
+
+    int MULTREGTScanner::RegionTable::at(int region1, int region2) const {
+        const int index1 = this->index( region1 );
+        if (index1 < 0) return -1;
+
+        const int index2 = this->index( region2 );
+        if (index2 < 0) return -1;
+
+        return this->records[ index1 * this->regions.size() + index2 ];
+    }
+
+
     void MULTREGTScanner::assertKeywordSupported( const DeckKeyword& deckKeyword, const std::string& defaultRegion) {
         for (auto iter = deckKeyword.begin(); iter != deckKeyword.end(); ++iter) {
             MULTREGTRecord record( *iter , defaultRegion);
@@ -231,29 +281,31 @@ namespace Opm {
          -----------
 
     */
-    double MULTREGTScanner::getRegionMultiplier(size_t globalIndex1 , size_t globalIndex2, FaceDir::DirEnum faceDir) const {
-
-        for (auto iter = m_searchMap.begin(); iter != m_searchMap.end(); iter++) {
-            const Opm::GridProperty<int>& region = m_e3DProps.getIntGridProperty( (*iter).first );
-            MULTREGTSearchMap map = (*iter).second;
-
-            int regionId1 = region.iget(globalIndex1);
-            int regionId2 = region.iget(globalIndex2);
-
-
-            std::pair<int,int> pair{regionId1 , regionId2};
-            if (map.count(pair) != 1 || !(map.at(pair)->m_directions & faceDir)) {
-                pair = std::pair<int,int>{regionId2 , regionId1};
-                if (map.count(pair) != 1 || !(map.at(pair)->m_directions & faceDir))
+    double MULTREGTScanner::getRegionMultiplier(const std::vector< const GridProperty< int >* >& regions,
+                                                size_t nx, size_t ny,
+                                                size_t globalIndex1, size_t globalIndex2,
+                                                FaceDir::DirEnum faceDir) const {
+
+        for (size_t t = 0; t < m_regionTables.size(); t++) {
+            const auto& table = m_regionTables[t];
+            const auto& region = *regions[t];
+
+            int regionId1 = region.iget( globalIndex1 );
+            int regionId2 = region.iget( globalIndex2 );
+
+            int pos = table.at( regionId1, regionId2 );
+            if (pos < 0 || !(m_records[pos].m_directions & faceDir)) {
+                pos = table.at( regionId2, regionId1 );
+                if (pos < 0 || !(m_records[pos].m_directions & faceDir))
                     continue;
             }
-            const MULTREGTRecord * record = map[pair];
+            const MULTREGTRecord * record = &m_records[pos];
 
             bool applyMultiplier = true;
-            int i1 = globalIndex1 % region.getNX();
-            int i2 = globalIndex2 % region.getNX();
-            int j1 = globalIndex1 / region.getNX() % region.getNY();
-            int j2 = globalIndex2 / region.getNX() % region.getNY();
+            int i1 = globalIndex1 % nx;
+            int i2 = globalIndex2 % nx;
+            int j1 = globalIndex1 / nx % ny;
+            int j2 = globalIndex2 / nx % ny;
 
             if (record->m_nncBehaviour == MULTREGT::NNC){
                 applyMultiplier = true;
@@ -273,4 +325,112 @@ namespace Opm {
         }
         return 1;
     }
+
+
+    /*
+      The region properties are looked up, and possibly finalized, before
+      any threads are started. They are read with iget(), which also
+      works for compressed properties, where the inactive cells are in
+      region 0.
+    */
+    std::vector< const GridProperty< int >* > MULTREGTScanner::regionData() const {
+        std::vector< const GridProperty< int >* > regions;
+        for (const auto& table : m_regionTables)
+            regions.push_back( &m_e3DProps.getIntGridProperty( table.keyword ) );
+
+        return regions;
+    }
+
+
+    double MULTREGTScanner::getRegionMultiplier(size_t globalIndex1 , size_t globalIndex2, FaceDir::DirEnum faceDir) const {
+        if (m_regionTables.empty())
+            return 1;
+
+        const auto regions = regionData();
+        for (const auto* region : regions) {
+            if (globalIndex1 >= region->getCartesianSize() || globalIndex2 >= region->getCartesianSize())
+                throw std::out_of_range("Invalid global index for MULTREGT");
+        }
+
+        const auto& region = *regions.front();
+        return getRegionMultiplier( regions, region.getNX(), region.getNY(),
+                                    globalIndex1, globalIndex2, faceDir );
+    }
+
+
+    std::vector<double> MULTREGTScanner::getRegionMultipliers(const GridDims& dims, FaceDir::DirEnum faceDir, size_t threads) const {
+        const size_t nx = dims.getNX();
+        const size_t ny = dims.getNY();
+        const size_t nz = dims.getNZ();
+        std::vector<double> multipliers( nx * ny * nz, 1.0 );
+        if (m_regionTables.empty())
+            return multipliers;
+
+        size_t stride;
+        switch (faceDir) {
+            case FaceDir::XPlus: stride = 1; break;
+            case FaceDir::YPlus: stride = nx; break;
+            case FaceDir::ZPlus: stride = nx * ny; break;
+            default:
+                throw std::invalid_argument("Region multipliers are only computed for the XPlus, YPlus and ZPlus faces");
+        }
+
+        const auto regions = regionData();
+        for (const auto* region : regions) {
+            if (region->getCartesianSize() != multipliers.size())
+                throw std::invalid_argument("The region properties do not match the grid dimensions");
+        }
+
+        parallel_for( multipliers.size(), threads, [&]( size_t begin, size_t end ) {
+            for (size_t g = begin; g < end; g++) {
+                const size_t i = g % nx;
+                const size_t j = g / nx % ny;
+                const size_t k = g / ( nx * ny );
+
+                const bool boundary = ( faceDir == FaceDir::XPlus && i + 1 == nx )
+                                   || ( faceDir == FaceDir::YPlus && j + 1 == ny )
+                                   || ( faceDir == FaceDir::ZPlus && k + 1 == nz );
+                if (boundary) continue;
+
+                multipliers[g] = this->getRegionMultiplier( regions, nx, ny, g, g + stride, faceDir );
+            }
+        } );
+
+        return multipliers;
+    }
+
+
+    std::vector<double> MULTREGTScanner::getRegionMultipliers(const GridDims& dims, const NNC& nnc) const {
+        const auto& connections = nnc.nncdata();
+        std::vector<double> multipliers( connections.size(), 1.0 );
+        if (m_regionTables.empty())
+            return multipliers;
+
+        const size_t nx = dims.getNX();
+        const size_t ny = dims.getNY();
+        const size_t size = nx * ny * dims.getNZ();
+
+        const auto regions = regionData();
+        for (const auto* region : regions) {
+            if (region->getCartesianSize() != size)
+                throw std::invalid_argument("The region properties do not match the grid dimensions");
+        }
+
+        for (size_t c = 0; c < connections.size(); c++) {
+            const auto cell1 = connections[c].cell1;
+            const auto cell2 = connections[c].cell2;
+            if (cell1 >= size || cell2 >= size)
+                throw std::out_of_range("Invalid global index in NNC");
+
+            FaceDir::DirEnum faceDir = FaceDir::ZPlus;
+            if (cell1 % nx != cell2 % nx)
+                faceDir = FaceDir::XPlus;
+            else if (cell1 / nx % ny != cell2 / nx % ny)
+                faceDir = FaceDir::YPlus;
+
+            multipliers[c] = getRegionMultiplier( regions, nx, ny, cell1, cell2, faceDir );
+        }
+
+        return multipliers;
+    }
 }
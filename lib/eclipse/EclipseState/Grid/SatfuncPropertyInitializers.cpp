@@ -15,7 +15,9 @@
 */
 
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 
 #include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
@@ -29,10 +31,14 @@
 #include <opm/parser/eclipse/EclipseState/Tables/SwfnTable.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/SwofTable.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/Tabdims.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableColumn.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableContainer.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableIndex.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
 #include <opm/parser/eclipse/Utility/Functional.hpp>
 
+#include "parallel_for.hpp"
+
 namespace Opm {
 
     /*
@@ -654,113 +660,245 @@ namespace Opm {
         }
     }
 
-    static double selectValue( const TableContainer& depthTables,
-                               int tableIdx,
-                               const std::string& columnName,
-                               double cellDepth,
-                               double fallbackValue,
-                               bool useOneMinusTableValue) {
+namespace {
 
-        if( tableIdx < 0 ) return fallbackValue;
+    /*
+     * The endpoint scaling keywords: the column of the ENPTVD (or IMPTVD for
+     * the imbibition keywords) table which gives the value as a function of
+     * depth, and the per table value used for the cells which have no such
+     * table.
+     */
+    struct Endpoint {
+        const char* keyword;
+        const char* column;
+        std::vector< double > (*fallback)( const TableManager* );
+        bool imbibition;
+        bool useOneMinusTableValue;
+    };
+
+    const Endpoint endpoints[] = {
+        { "SGL",    "SGCO",    findMinGasSaturation,    false, false },
+        { "ISGL",   "SGCO",    findMinGasSaturation,    true,  false },
+        { "SGU",    "SGMAX",   findMaxGasSaturation,    false, false },
+        { "ISGU",   "SGMAX",   findMaxGasSaturation,    true,  false },
+        { "SWL",    "SWCO",    findMinWaterSaturation,  false, false },
+        { "ISWL",   "SWCO",    findMinWaterSaturation,  true,  false },
+        { "SWU",    "SWMAX",   findMaxWaterSaturation,  false, true  },
+        { "ISWU",   "SWMAX",   findMaxWaterSaturation,  true,  true  },
+        { "SGCR",   "SGCRIT",  findCriticalGas,         false, false },
+        { "ISGCR",  "SGCRIT",  findCriticalGas,         true,  false },
+        { "SOWCR",  "SOWCRIT", findCriticalOilWater,    false, false },
+        { "ISOWCR", "SOWCRIT", findCriticalOilWater,    true,  false },
+        { "SOGCR",  "SOGCRIT", findCriticalOilGas,      false, false },
+        { "ISOGCR", "SOGCRIT", findCriticalOilGas,      true,  false },
+        { "SWCR",   "SWCRIT",  findCriticalWater,       false, false },
+        { "ISWCR",  "SWCRIT",  findCriticalWater,       true,  false },
+        { "PCW",    "PCW",     findMaxPcow,             false, false },
+        { "IPCW",   "IPCW",    findMaxPcow,             true,  false },
+        { "PCG",    "PCG",     findMaxPcog,             false, false },
+        { "IPCG",   "IPCG",    findMaxPcog,             true,  false },
+        { "KRW",    "KRW",     findMaxKrw,              false, false },
+        { "IKRW",   "IKRW",    findKrwr,                true,  false },
+        { "KRWR",   "KRWR",    findKrwr,                false, false },
+        { "IKRWR",  "IKRWR",   findKrwr,                true,  false },
+        { "KRO",    "KRO",     findMaxKro,              false, false },
+        { "IKRO",   "IKRO",    findMaxKro,              true,  false },
+        { "KRORW",  "KRORW",   findKrorw,               false, false },
+        { "IKRORW", "IKRORW",  findKrorw,               true,  false },
+        { "KRORG",  "KRORG",   findKrorg,               false, false },
+        { "IKRORG", "IKRORG",  findKrorg,               true,  false },
+        { "KRG",    "KRG",     findMaxKrg,              false, false },
+        { "IKRG",   "IKRG",    findMaxKrg,              true,  false },
+        { "KRGR",   "KRGR",    findKrgr,                false, false },
+        { "IKRGR",  "IKRGR",   findKrgr,                true,  false }
+    };
+
+    const Endpoint& findEndpoint( const std::string& keyword ) {
+        for( const auto& endpoint : endpoints )
+            if( keyword == endpoint.keyword ) return endpoint;
+
+        throw std::invalid_argument( "No endpoint scaling keyword " + keyword );
+    }
 
-        const auto& table = depthTables.getTable( tableIdx );
+    /*
+     * The ENPTVD or IMPTVD tables: the depth column, and the value columns
+     * of the requested keywords, so that the depth bracket of a cell is
+     * found once for all the keywords.
+     */
+    struct DepthTables {
+        DepthTables( const TableContainer& tables, bool use ) :
+            use( use ),
+            size( tables.size() )
+        {
+            if( !use ) return;
+
+            for( size_t t = 0; t < this->size; ++t )
+                this->depth.push_back( &tables.getTable( t ).getColumn( 0 ) );
+        }
 
-        if( tableIdx >= int( depthTables.size() ) )
-            throw std::invalid_argument("Not enough tables!");
+        void addColumn( const TableContainer& tables, const std::string& name ) {
+            if( !this->use ) return;
 
-        // evaluate the table at the cell depth
-        const double value = table.evaluate( columnName, cellDepth );
+            for( size_t t = 0; t < this->size; ++t )
+                this->columns.push_back( &tables.getTable( t ).getColumn( name ) );
+        }
 
-        // a column can be fully defaulted. In this case, eval() returns a NaN
-        // and we have to use the data from saturation tables
-        if( !std::isfinite( value ) ) return fallbackValue;
-        if( useOneMinusTableValue ) return 1 - value;
-        return value;
-    }
+        bool use;
+        size_t size;
+        std::vector< const TableColumn* > depth;
+        /* column of endpoint k in table t at k * size + t */
+        std::vector< const TableColumn* > columns;
+    };
+
+    std::vector< std::vector< double > >
+    endpointApply( size_t size,
+                   const std::vector< const Endpoint* >& requested,
+                   const TableManager* tableManager,
+                   const EclipseGrid* eclipseGrid,
+                   const GridProperties<int>* intGridProperties,
+                   size_t threads ) {
+
+        const auto num = requested.size();
+
+        /* the per table values, computed once for the keywords sharing them */
+        std::vector< std::vector< double > > fallbacks;
+        std::vector< size_t > fallbackIndex;
+        for( size_t k = 0; k < num; ++k ) {
+            size_t f = 0;
+            while( f < k && requested[ f ]->fallback != requested[ k ]->fallback ) ++f;
+
+            if( f < k ) {
+                fallbackIndex.push_back( fallbackIndex[ f ] );
+            } else {
+                fallbackIndex.push_back( fallbacks.size() );
+                fallbacks.push_back( requested[ k ]->fallback( tableManager ) );
+            }
+        }
 
-    static std::vector< double > satnumApply( size_t size,
-                                              const std::string& columnName,
-                                              const std::vector< double >& fallbackValues,
-                                              const TableManager* tableManager,
-                                              const EclipseGrid* eclipseGrid,
-                                              const GridProperties<int>* intGridProperties,
-                                              bool useOneMinusTableValue ) {
+        const auto imbibition = []( const Endpoint* ep ) { return ep->imbibition; };
+        const bool anyImbibition = std::any_of( requested.begin(), requested.end(), imbibition );
+        const bool anyDrainage = !std::all_of( requested.begin(), requested.end(), imbibition );
 
+        const int numSatTables = tableManager->getTabdims().getNumSatTables();
+        const GridProperty< int >* satnum = nullptr;
+        const GridProperty< int >* imbnum = nullptr;
+        if( anyDrainage ) {
+            satnum = &intGridProperties->getKeyword("SATNUM");
+            satnum->checkLimits( 1 , numSatTables );
+        }
+        if( anyImbibition ) {
+            imbnum = &intGridProperties->getKeyword("IMBNUM");
+            imbnum->checkLimits( 1 , numSatTables );
+        }
+        const auto& endnum = intGridProperties->getKeyword("ENDNUM");
 
-        std::vector< double > values( size, 0 );
-        auto tabdims = tableManager->getTabdims();
+        const auto& enptvdTables = tableManager->getEnptvdTables();
+        const auto& imptvdTables = tableManager->getImptvdTables();
+        DepthTables enptvd( enptvdTables, anyDrainage && tableManager->useEnptvd() );
+        DepthTables imptvd( imptvdTables, anyImbibition && tableManager->useImptvd() );
+        for( const auto* ep : requested ) {
+            if( ep->imbibition ) imptvd.addColumn( imptvdTables, ep->column );
+            else                 enptvd.addColumn( enptvdTables, ep->column );
+        }
 
-        const auto& satnum = intGridProperties->getKeyword("SATNUM");
-        const auto& endnum = intGridProperties->getKeyword("ENDNUM");
-        int numSatTables = tabdims.getNumSatTables();
+        /* the position of each keyword among those of its depth tables */
+        std::vector< size_t > columnIndex;
+        size_t numDrainage = 0, numImbibition = 0;
+        for( const auto* ep : requested )
+            columnIndex.push_back( ep->imbibition ? numImbibition++ : numDrainage++ );
 
-        satnum.checkLimits( 1 , numSatTables );
+        const std::vector< double > noDepths;
+        const auto& depths = enptvd.use || imptvd.use
+                           ? eclipseGrid->getCellDepths( threads )
+                           : noDepths;
 
-        // acctually assign the defaults. if the ENPVD keyword was specified in the deck,
-        // this currently cannot be done because we would need the Z-coordinate of the
-        // cell and we would need to know how the simulator wants to interpolate between
-        // sampling points. Both of these are outside the scope of opm-parser, so we just
-        // assign a NaN in this case...
-        const bool useEnptvd = tableManager->useEnptvd();
-        const auto& enptvdTables = tableManager->getEnptvdTables();
+        std::vector< std::vector< double > > values( num, std::vector< double >( size, 0 ) );
 
         const auto gridsize = eclipseGrid->getCartesianSize();
-        for( size_t cellIdx = 0; cellIdx < gridsize; cellIdx++ ) {
-            int satTableIdx = satnum.iget( cellIdx ) - 1;
-            int endNum = endnum.iget( cellIdx ) - 1;
-            double cellDepth = eclipseGrid->getCellDepth( cellIdx );
-
-
-            values[cellIdx] = selectValue(enptvdTables,
-                                        (useEnptvd && endNum >= 0) ? endNum : -1,
-                                        columnName,
-                                        cellDepth,
-                                        fallbackValues[ satTableIdx ],
-                                        useOneMinusTableValue);
-        }
+        parallel_for( gridsize, threads, [&]( size_t begin, size_t end ) {
+            const auto bracket = []( const DepthTables& tables, int endNum, double depth ) {
+                if( endNum >= int( tables.size ) )
+                    throw std::invalid_argument("Not enough tables!");
+
+                return tables.depth[ endNum ]->lookup( depth );
+            };
+
+            for( size_t cellIdx = begin; cellIdx < end; cellIdx++ ) {
+                // the inactive cells of a compressed SATNUM or IMBNUM have no table
+                const bool satActive = satnum
+                    && !( satnum->isCompressed() && !eclipseGrid->cellActive( cellIdx ) );
+                const bool imbActive = imbnum
+                    && !( imbnum->isCompressed() && !eclipseGrid->cellActive( cellIdx ) );
+                if( !satActive && !imbActive ) continue;
+
+                const int endNum = endnum.iget( cellIdx ) - 1;
+
+                const int satTableIdx = satActive ? satnum->iget( cellIdx ) - 1 : 0;
+                const int imbTableIdx = imbActive ? imbnum->iget( cellIdx ) - 1 : 0;
+
+                const bool satDepth = satActive && enptvd.use && endNum >= 0;
+                const bool imbDepth = imbActive && imptvd.use && endNum >= 0;
+
+                const auto satIndex = satDepth ? bracket( enptvd, endNum, depths[ cellIdx ] )
+                                               : TableIndex( 0, 1.0 );
+                const auto imbIndex = imbDepth ? bracket( imptvd, endNum, depths[ cellIdx ] )
+                                               : TableIndex( 0, 1.0 );
+
+                for( size_t k = 0; k < num; ++k ) {
+                    const auto& ep = *requested[ k ];
+                    if( !( ep.imbibition ? imbActive : satActive ) ) continue;
+
+                    const int tableIdx = ep.imbibition ? imbTableIdx : satTableIdx;
+                    const double fallback = fallbacks[ fallbackIndex[ k ] ][ tableIdx ];
+
+                    const bool useDepth = ep.imbibition ? imbDepth : satDepth;
+                    if( !useDepth ) {
+                        values[ k ][ cellIdx ] = fallback;
+                        continue;
+                    }
+
+                    const auto& tables = ep.imbibition ? imptvd : enptvd;
+                    const auto& column = *tables.columns[ columnIndex[ k ] * tables.size + endNum ];
+
+                    // a column can be fully defaulted. In this case, eval() returns a NaN
+                    // and we have to use the data from saturation tables
+                    const double value = column.eval( ep.imbibition ? imbIndex : satIndex );
+                    if( !std::isfinite( value ) )         values[ k ][ cellIdx ] = fallback;
+                    else if( ep.useOneMinusTableValue )   values[ k ][ cellIdx ] = 1 - value;
+                    else                                  values[ k ][ cellIdx ] = value;
+                }
+            }
+        });
 
         return values;
     }
 
-    static std::vector< double > imbnumApply( size_t size,
-                                              const std::string& columnName,
-                                              const std::vector< double >& fallBackValues,
-                                              const TableManager* tableManager,
-                                              const EclipseGrid* eclipseGrid,
-                                              const GridProperties<int>* intGridProperties,
-                                              bool useOneMinusTableValue ) {
+    std::vector< double > endpointApply( size_t size,
+                                         const std::string& keyword,
+                                         const TableManager* tableManager,
+                                         const EclipseGrid* eclipseGrid,
+                                         GridProperties<int>* intGridProperties ) {
+        return std::move( endpointApply( size, { &findEndpoint( keyword ) },
+                                         tableManager, eclipseGrid,
+                                         intGridProperties, 1 ).front() );
+    }
 
-        std::vector< double > values( size, 0 );
+}
 
-        const auto& imbnum = intGridProperties->getKeyword("IMBNUM");
-        const auto& endnum = intGridProperties->getKeyword("ENDNUM");
+    std::vector< std::vector< double > >
+    endpointScaling( const std::vector< std::string >& keywords,
+                     const TableManager* tableManager,
+                     const EclipseGrid* eclipseGrid,
+                     const GridProperties<int>* intGridProperties,
+                     size_t threads ) {
 
-        auto tabdims = tableManager->getTabdims();
-        const int numSatTables = tabdims.getNumSatTables();
-
-        imbnum.checkLimits( 1 , numSatTables );
-        // acctually assign the defaults. if the ENPVD keyword was specified in the deck,
-        // this currently cannot be done because we would need the Z-coordinate of the
-        // cell and we would need to know how the simulator wants to interpolate between
-        // sampling points. Both of these are outside the scope of opm-parser, so we just
-        // assign a NaN in this case...
-        const bool useImptvd = tableManager->useImptvd();
-        const TableContainer& imptvdTables = tableManager->getImptvdTables();
-        const auto gridsize = eclipseGrid->getCartesianSize();
-        for( size_t cellIdx = 0; cellIdx < gridsize; cellIdx++ ) {
-            int imbTableIdx = imbnum.iget( cellIdx ) - 1;
-            int endNum = endnum.iget( cellIdx ) - 1;
-            double cellDepth = eclipseGrid->getCellDepth( cellIdx );
-
-            values[cellIdx] = selectValue(imptvdTables,
-                                                (useImptvd && endNum >= 0) ? endNum : -1,
-                                                columnName,
-                                                cellDepth,
-                                                fallBackValues[imbTableIdx],
-                                                useOneMinusTableValue);
-        }
+        std::vector< const Endpoint* > requested;
+        for( const auto& keyword : keywords )
+            requested.push_back( &findEndpoint( keyword ) );
 
-        return values;
+        return endpointApply( eclipseGrid->getCartesianSize(), requested,
+                              tableManager, eclipseGrid, intGridProperties,
+                              threads );
     }
 
     std::vector< double > SGLEndpoint( size_t size,
@@ -768,9 +906,7 @@ namespace Opm {
                                        const EclipseGrid* eclipseGrid,
                                        GridProperties<int>* intGridProperties )
     {
-        const auto min_gas = findMinGasSaturation( tableManager );
-        return satnumApply( size, "SGCO", min_gas, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "SGL", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > ISGLEndpoint( size_t size,
@@ -778,9 +914,7 @@ namespace Opm {
                                         const EclipseGrid* eclipseGrid,
                                         GridProperties<int>* intGridProperties )
     {
-        const auto min_gas = findMinGasSaturation( tableManager );
-        return imbnumApply( size, "SGCO", min_gas, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "ISGL", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > SGUEndpoint( size_t size,
@@ -788,9 +922,7 @@ namespace Opm {
                                        const EclipseGrid* eclipseGrid,
                                        GridProperties<int>* intGridProperties )
     {
-        const auto max_gas = findMaxGasSaturation( tableManager );
-        return satnumApply( size, "SGMAX", max_gas, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "SGU", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > ISGUEndpoint( size_t size,
@@ -798,9 +930,7 @@ namespace Opm {
                                         const EclipseGrid* eclipseGrid,
                                         GridProperties<int>* intGridProperties )
     {
-        const auto max_gas = findMaxGasSaturation( tableManager );
-        return imbnumApply( size, "SGMAX", max_gas, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "ISGU", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > SWLEndpoint( size_t size,
@@ -808,9 +938,7 @@ namespace Opm {
                                        const EclipseGrid* eclipseGrid,
                                        GridProperties<int>* intGridProperties )
     {
-        const auto min_water = findMinWaterSaturation( tableManager );
-        return satnumApply( size, "SWCO", min_water, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "SWL", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > ISWLEndpoint( size_t size,
@@ -818,9 +946,7 @@ namespace Opm {
                                         const EclipseGrid  * eclipseGrid,
                                         GridProperties<int>* intGridProperties )
     {
-        const auto min_water = findMinWaterSaturation( tableManager );
-        return imbnumApply( size, "SWCO", min_water, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "ISWL", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > SWUEndpoint( size_t size,
@@ -828,9 +954,7 @@ namespace Opm {
                                        const EclipseGrid  * eclipseGrid,
                                        GridProperties<int>* intGridProperties )
     {
-        const auto max_water = findMaxWaterSaturation( tableManager );
-        return satnumApply( size, "SWMAX", max_water, tableManager, eclipseGrid,
-                            intGridProperties, true );
+        return endpointApply( size, "SWU", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > ISWUEndpoint( size_t size,
@@ -838,9 +962,7 @@ namespace Opm {
                                         const EclipseGrid  * eclipseGrid,
                                         GridProperties<int>* intGridProperties )
     {
-        const auto max_water = findMaxWaterSaturation( tableManager );
-        return imbnumApply( size, "SWMAX", max_water, tableManager, eclipseGrid,
-                            intGridProperties, true);
+        return endpointApply( size, "ISWU", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > SGCREndpoint( size_t size,
@@ -848,9 +970,7 @@ namespace Opm {
                                         const EclipseGrid  * eclipseGrid,
                                         GridProperties<int>* intGridProperties )
     {
-        const auto crit_gas = findCriticalGas( tableManager );
-        return satnumApply( size, "SGCRIT", crit_gas, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "SGCR", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > ISGCREndpoint( size_t size,
@@ -858,9 +978,7 @@ namespace Opm {
                                          const EclipseGrid  * eclipseGrid,
                                          GridProperties<int>* intGridProperties )
     {
-        const auto crit_gas = findCriticalGas( tableManager );
-        return imbnumApply( size, "SGCRIT", crit_gas, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "ISGCR", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > SOWCREndpoint( size_t size,
@@ -868,9 +986,7 @@ namespace Opm {
                                          const EclipseGrid  * eclipseGrid,
                                          GridProperties<int>* intGridProperties )
     {
-        const auto oil_water = findCriticalOilWater( tableManager );
-        return satnumApply( size, "SOWCRIT", oil_water, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "SOWCR", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > ISOWCREndpoint( size_t size,
@@ -878,9 +994,7 @@ namespace Opm {
                                           const EclipseGrid  * eclipseGrid,
                                           GridProperties<int>* intGridProperties )
     {
-        const auto oil_water = findCriticalOilWater( tableManager );
-        return imbnumApply( size, "SOWCRIT", oil_water, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "ISOWCR", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > SOGCREndpoint( size_t size,
@@ -888,9 +1002,7 @@ namespace Opm {
                                          const EclipseGrid  * eclipseGrid,
                                          GridProperties<int>* intGridProperties )
     {
-        const auto crit_oil_gas = findCriticalOilGas( tableManager );
-        return satnumApply( size, "SOGCRIT", crit_oil_gas, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "SOGCR", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > ISOGCREndpoint( size_t size,
@@ -898,9 +1010,7 @@ namespace Opm {
                                           const EclipseGrid  * eclipseGrid,
                                           GridProperties<int>* intGridProperties )
     {
-        const auto crit_oil_gas = findCriticalOilGas( tableManager );
-        return imbnumApply( size, "SOGCRIT", crit_oil_gas, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "ISOGCR", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > SWCREndpoint( size_t size,
@@ -908,9 +1018,7 @@ namespace Opm {
                                         const EclipseGrid  * eclipseGrid,
                                         GridProperties<int>* intGridProperties )
     {
-        const auto crit_water = findCriticalWater( tableManager );
-        return satnumApply( size, "SWCRIT", crit_water, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "SWCR", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > ISWCREndpoint( size_t size,
@@ -918,9 +1026,7 @@ namespace Opm {
                                          const EclipseGrid  * eclipseGrid,
                                          GridProperties<int>* intGridProperties )
     {
-        const auto crit_water = findCriticalWater( tableManager );
-        return imbnumApply( size, "SWCRIT", crit_water, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "ISWCR", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > PCWEndpoint( size_t size,
@@ -928,9 +1034,7 @@ namespace Opm {
                                        const EclipseGrid  * eclipseGrid,
                                        GridProperties<int>* intGridProperties )
     {
-        const auto max_pcow = findMaxPcow( tableManager );
-        return satnumApply( size, "PCW", max_pcow, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "PCW", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > IPCWEndpoint( size_t size,
@@ -938,9 +1042,7 @@ namespace Opm {
                                         const EclipseGrid  * eclipseGrid,
                                         GridProperties<int>* intGridProperties )
     {
-        const auto max_pcow = findMaxPcow( tableManager );
-        return imbnumApply( size, "IPCW", max_pcow, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "IPCW", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > PCGEndpoint( size_t size,
@@ -948,9 +1050,7 @@ namespace Opm {
                                        const EclipseGrid  * eclipseGrid,
                                        GridProperties<int>* intGridProperties )
     {
-        const auto max_pcog = findMaxPcog( tableManager );
-        return satnumApply( size, "PCG", max_pcog, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "PCG", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > IPCGEndpoint( size_t size,
@@ -958,9 +1058,7 @@ namespace Opm {
                                         const EclipseGrid  * eclipseGrid,
                                         GridProperties<int>* intGridProperties )
     {
-        const auto max_pcog = findMaxPcog( tableManager );
-        return imbnumApply( size, "IPCG", max_pcog, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "IPCG", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > KRWEndpoint( size_t size,
@@ -968,9 +1066,7 @@ namespace Opm {
                                        const EclipseGrid  * eclipseGrid,
                                        GridProperties<int>* intGridProperties )
     {
-        const auto max_krw = findMaxKrw( tableManager );
-        return satnumApply( size, "KRW", max_krw, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "KRW", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > IKRWEndpoint( size_t size,
@@ -978,9 +1074,7 @@ namespace Opm {
                                         const EclipseGrid  * eclipseGrid,
                                         GridProperties<int>* intGridProperties )
     {
-        const auto krwr = findKrwr( tableManager );
-        return imbnumApply( size, "IKRW", krwr, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "IKRW", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > KRWREndpoint( size_t size,
@@ -988,9 +1082,7 @@ namespace Opm {
                                         const EclipseGrid  * eclipseGrid,
                                         GridProperties<int>* intGridProperties )
     {
-        const auto krwr = findKrwr( tableManager );
-        return satnumApply( size, "KRWR", krwr, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "KRWR", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > IKRWREndpoint( size_t size,
@@ -998,9 +1090,7 @@ namespace Opm {
                                          const EclipseGrid  * eclipseGrid,
                                          GridProperties<int>* intGridProperties )
     {
-        const auto krwr = findKrwr( tableManager );
-        return imbnumApply( size, "IKRWR", krwr, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "IKRWR", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > KROEndpoint( size_t size,
@@ -1008,9 +1098,7 @@ namespace Opm {
                                        const EclipseGrid  * eclipseGrid,
                                        GridProperties<int>* intGridProperties )
     {
-        const auto max_kro = findMaxKro( tableManager );
-        return satnumApply( size, "KRO", max_kro, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "KRO", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > IKROEndpoint( size_t size,
@@ -1018,9 +1106,7 @@ namespace Opm {
                                         const EclipseGrid  * eclipseGrid,
                                         GridProperties<int>* intGridProperties )
     {
-        const auto max_kro = findMaxKro( tableManager );
-        return imbnumApply( size, "IKRO", max_kro, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "IKRO", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > KRORWEndpoint( size_t size,
@@ -1028,9 +1114,7 @@ namespace Opm {
                                          const EclipseGrid  * eclipseGrid,
                                          GridProperties<int>* intGridProperties )
     {
-        const auto krorw = findKrorw( tableManager );
-        return satnumApply( size, "KRORW", krorw, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "KRORW", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > IKRORWEndpoint( size_t size,
@@ -1038,9 +1122,7 @@ namespace Opm {
                                           const EclipseGrid  * eclipseGrid,
                                           GridProperties<int>* intGridProperties )
     {
-        const auto krorw = findKrorw( tableManager );
-        return imbnumApply( size, "IKRORW", krorw, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "IKRORW", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > KRORGEndpoint( size_t size,
@@ -1048,9 +1130,7 @@ namespace Opm {
                                          const EclipseGrid  * eclipseGrid,
                                          GridProperties<int>* intGridProperties )
     {
-        const auto krorg = findKrorg( tableManager );
-        return satnumApply( size, "KRORG", krorg, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "KRORG", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > IKRORGEndpoint( size_t size,
@@ -1058,9 +1138,7 @@ namespace Opm {
                                           const EclipseGrid  * eclipseGrid,
                                           GridProperties<int>* intGridProperties )
     {
-        const auto krorg = findKrorg( tableManager );
-        return imbnumApply( size, "IKRORG", krorg, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "IKRORG", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > KRGEndpoint( size_t size,
@@ -1068,9 +1146,7 @@ namespace Opm {
                                        const EclipseGrid  * eclipseGrid,
                                        GridProperties<int>* intGridProperties )
     {
-        const auto max_krg = findMaxKrg( tableManager );
-        return satnumApply( size, "KRG", max_krg, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "KRG", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > IKRGEndpoint( size_t size,
@@ -1078,9 +1154,7 @@ namespace Opm {
                                         const EclipseGrid  * eclipseGrid,
                                         GridProperties<int>* intGridProperties )
     {
-        const auto max_krg = findMaxKrg( tableManager );
-        return imbnumApply( size, "IKRG", max_krg, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "IKRG", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > KRGREndpoint( size_t size,
@@ -1088,9 +1162,7 @@ namespace Opm {
                                         const EclipseGrid  * eclipseGrid,
                                         GridProperties<int>* intGridProperties )
     {
-        const auto krgr = findKrgr( tableManager );
-        return satnumApply( size, "KRGR", krgr, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "KRGR", tableManager, eclipseGrid, intGridProperties );
     }
 
     std::vector< double > IKRGREndpoint( size_t size,
@@ -1098,8 +1170,6 @@ namespace Opm {
                                          const EclipseGrid* eclipseGrid,
                                          GridProperties<int>* intGridProperties )
     {
-        const auto krgr = findKrgr( tableManager );
-        return imbnumApply( size, "IKRGR", krgr, tableManager, eclipseGrid,
-                            intGridProperties, false );
+        return endpointApply( size, "IKRGR", tableManager, eclipseGrid, intGridProperties );
     }
 }
@@ -17,6 +17,7 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <stdexcept>
 
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
@@ -28,20 +29,34 @@
 #include <opm/parser/eclipse/EclipseState/Grid/TransMult.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridDims.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/MULTREGTScanner.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/NNC.hpp>
+
+#include "parallel_for.hpp"
 
 
 namespace Opm {
 
+    namespace {
+
+        size_t slot( FaceDir::DirEnum faceDir ) {
+            switch (faceDir) {
+                case FaceDir::XPlus:  return 0;
+                case FaceDir::XMinus: return 1;
+                case FaceDir::YPlus:  return 2;
+                case FaceDir::YMinus: return 3;
+                case FaceDir::ZPlus:  return 4;
+                case FaceDir::ZMinus: return 5;
+                default:
+                    throw std::invalid_argument("Invalid face direction");
+            }
+        }
+
+    }
+
     TransMult::TransMult(const GridDims& dims, const Deck& deck, const Eclipse3DProperties& props) :
         m_nx( dims.getNX()),
         m_ny( dims.getNY()),
         m_nz( dims.getNZ()),
-        m_names( { { FaceDir::XPlus,  "MULTX"  },
-                   { FaceDir::YPlus,  "MULTY"  },
-                   { FaceDir::ZPlus,  "MULTZ"  },
-                   { FaceDir::XMinus, "MULTX-" },
-                   { FaceDir::YMinus, "MULTY-" },
-                   { FaceDir::ZMinus, "MULTZ-" }}),
         m_multregtScanner( props, deck.getKeywordList( "MULTREGT" ))
     {
     }
@@ -66,10 +81,20 @@ namespace Opm {
     }
 
     double TransMult::getMultiplier__(size_t globalIndex,  FaceDir::DirEnum faceDir) const {
-        if (hasDirectionProperty( faceDir )) {
-            return m_trans.at(faceDir).iget( globalIndex );
-        } else
-            return 1.0;
+        const size_t index = slot( faceDir );
+        const auto& dense = m_dense[index];
+        if (!dense.empty())
+            return dense[globalIndex];
+
+        const auto& sparse = m_sparse[index];
+        const auto face = std::lower_bound( sparse.begin(), sparse.end(), globalIndex,
+                                            []( const std::pair< size_t, double >& entry, size_t g ) {
+                                                return entry.first < g;
+                                            });
+        if (face != sparse.end() && face->first == globalIndex)
+            return face->second;
+
+        return 1.0;
     }
 
 
@@ -84,53 +109,178 @@ namespace Opm {
         return m_multregtScanner.getRegionMultiplier(globalCellIndex1, globalCellIndex2, faceDir);
     }
 
-    bool TransMult::hasDirectionProperty(FaceDir::DirEnum faceDir) const {
-        return m_trans.count(faceDir) == 1;
+    std::vector<double> TransMult::getRegionMultipliers(FaceDir::DirEnum faceDir, size_t threads) const {
+        return m_multregtScanner.getRegionMultipliers( GridDims( m_nx, m_ny, m_nz ), faceDir, threads );
     }
 
-    void TransMult::insertNewProperty(FaceDir::DirEnum faceDir) {
-        GridPropertySupportedKeywordInfo<double> kwInfo(m_names[faceDir] , 1.0 , "1");
-        GridProperty< double > prop( m_nx, m_ny, m_nz, kwInfo );
-        m_trans.emplace( faceDir, std::move( prop ) );
+    std::vector<double> TransMult::getRegionMultipliers(const NNC& nnc) const {
+        return m_multregtScanner.getRegionMultipliers( GridDims( m_nx, m_ny, m_nz ), nnc );
     }
 
 
-    GridProperty<double>& TransMult::getDirectionProperty(FaceDir::DirEnum faceDir) {
-        if (m_trans.count(faceDir) == 0)
-            insertNewProperty(faceDir);
+    std::vector<double> TransMult::getConnectionMultipliers(FaceDir::DirEnum faceDir, size_t threads) const {
+        size_t stride;
+        FaceDir::DirEnum minusDir;
+        switch (faceDir) {
+            case FaceDir::XPlus: stride = 1;             minusDir = FaceDir::XMinus; break;
+            case FaceDir::YPlus: stride = m_nx;          minusDir = FaceDir::YMinus; break;
+            case FaceDir::ZPlus: stride = m_nx * m_ny;   minusDir = FaceDir::ZMinus; break;
+            default:
+                throw std::invalid_argument("Connection multipliers are only computed for the XPlus, YPlus and ZPlus faces");
+        }
+
+        /* is there a neighbour in the positive direction of cell g */
+        const auto interior = [this,faceDir]( size_t g ) {
+            switch (faceDir) {
+                case FaceDir::XPlus: return g % m_nx + 1 < m_nx;
+                case FaceDir::YPlus: return g / m_nx % m_ny + 1 < m_ny;
+                default:             return g / (m_nx * m_ny) + 1 < m_nz;
+            }
+        };
+
+        auto multipliers = getRegionMultipliers( faceDir, threads );
+
+        const auto& plusDense = m_dense[ slot( faceDir ) ];
+        const auto& minusDense = m_dense[ slot( minusDir ) ];
+        if (!plusDense.empty() || !minusDense.empty()) {
+            parallel_for( multipliers.size(), threads, [&]( size_t begin, size_t end ) {
+                for (size_t g = begin; g < end; ++g) {
+                    if (!interior( g ))
+                        continue;
+
+                    if (!plusDense.empty())
+                        multipliers[g] *= plusDense[g];
+                    if (!minusDense.empty())
+                        multipliers[g] *= minusDense[g + stride];
+                }
+            });
+        }
+
+        /* the faults touch few faces, so their lists are applied directly */
+        for (const auto& face : m_sparse[ slot( faceDir ) ]) {
+            if (interior( face.first ))
+                multipliers[face.first] *= face.second;
+        }
+
+        for (const auto& face : m_sparse[ slot( minusDir ) ]) {
+            if (face.first >= stride && interior( face.first - stride ))
+                multipliers[face.first - stride] *= face.second;
+        }
 
-        return m_trans.at( faceDir );
+        return multipliers;
+    }
+
+
+    /*
+      Switching a direction to a dense array folds in the fault
+      multipliers already applied to it.
+    */
+    std::vector<double>& TransMult::getDenseMultipliers(FaceDir::DirEnum faceDir) {
+        const size_t index = slot( faceDir );
+        auto& dense = m_dense[index];
+        if (dense.empty()) {
+            dense.assign( m_nx * m_ny * m_nz, 1.0 );
+            for (const auto& face : m_sparse[index])
+                dense[face.first] *= face.second;
+
+            FaceList().swap( m_sparse[index] );
+        }
+
+        return dense;
     }
 
     void TransMult::applyMULT(const GridProperty<double>& srcProp, FaceDir::DirEnum faceDir)
     {
-        auto& dstProp = getDirectionProperty(faceDir);
+        auto& dstData = getDenseMultipliers(faceDir);
+
+        if (srcProp.isCompressed()) {
+            // the faces of the inactive cells keep their multiplier
+            const auto& activeIndex = srcProp.getActiveIndex();
+            const auto& srcData = srcProp.getCompressedData();
+            if (activeIndex.size() != dstData.size())
+                throw std::invalid_argument("The multiplier property does not match the grid dimensions");
+
+            for (size_t i = 0; i < activeIndex.size(); ++i) {
+                if (activeIndex[i] >= 0)
+                    dstData[i] *= srcData[ activeIndex[i] ];
+            }
+            return;
+        }
 
         const std::vector<double> &srcData = srcProp.getData();
+        if (srcData.size() != dstData.size())
+            throw std::invalid_argument("The multiplier property does not match the grid dimensions");
+
         for (size_t i = 0; i < srcData.size(); ++i)
-            dstProp.multiplyValueAtIndex(i, srcData[i]);
+            dstData[i] *= srcData[i];
     }
 
 
-    void TransMult::applyMULTFLT(const Fault& fault) {
+    /*
+      Multiply the fault multiplier into the dense arrays directly, and
+      gather the faces of the other directions in faces.
+    */
+    void TransMult::collectMULTFLT(const Fault& fault, std::array< FaceList, 6 >& faces) {
         double transMult = fault.getTransMult();
 
         for( const auto& face : fault ) {
-            FaceDir::DirEnum faceDir = face.getDir();
-            auto& multProperty = getDirectionProperty(faceDir);
-
+            const size_t index = slot( face.getDir() );
+            auto& dense = m_dense[index];
 
             for( auto globalIndex : face ) {
-                multProperty.multiplyValueAtIndex( globalIndex , transMult);
+                if (dense.empty())
+                    faces[index].emplace_back( globalIndex , transMult );
+                else
+                    dense[globalIndex] *= transMult;
             }
         }
     }
 
 
+    /*
+      Merge the gathered faces into the sorted lists. The sort is stable
+      and the existing entries come first, so the multipliers of a face
+      are multiplied together in the order they were applied.
+    */
+    void TransMult::mergeMULTFLT(std::array< FaceList, 6 >& faces) {
+        const auto byIndex = []( const std::pair< size_t, double >& a, const std::pair< size_t, double >& b ) {
+            return a.first < b.first;
+        };
+
+        for (size_t index = 0; index < faces.size(); ++index) {
+            if (faces[index].empty())
+                continue;
+
+            auto& sparse = m_sparse[index];
+            sparse.insert( sparse.end(), faces[index].begin(), faces[index].end() );
+            std::stable_sort( sparse.begin(), sparse.end(), byIndex );
+
+            size_t last = 0;
+            for (size_t i = 1; i < sparse.size(); ++i) {
+                if (sparse[i].first == sparse[last].first)
+                    sparse[last].second *= sparse[i].second;
+                else
+                    sparse[++last] = sparse[i];
+            }
+            sparse.resize( last + 1 );
+            sparse.shrink_to_fit();
+        }
+    }
+
+
+    void TransMult::applyMULTFLT(const Fault& fault) {
+        std::array< FaceList, 6 > faces;
+        collectMULTFLT( fault, faces );
+        mergeMULTFLT( faces );
+    }
+
+
     void TransMult::applyMULTFLT(const FaultCollection& faults) {
+        std::array< FaceList, 6 > faces;
         for (size_t faultIndex = 0; faultIndex < faults.size(); faultIndex++) {
             auto& fault = faults.getFault(faultIndex);
-            applyMULTFLT(fault);
+            collectMULTFLT(fault, faces);
         }
+        mergeMULTFLT( faces );
     }
-    }
+}
@@ -0,0 +1,64 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PARALLEL_FOR_HPP
+#define OPM_PARALLEL_FOR_HPP
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace Opm {
+
+    /*
+      Call f( begin, end ) for consecutive blocks of [0, size), on up to
+      threads threads. Small ranges are not split. If f throws, the first
+      exception is rethrown when all the blocks are done.
+    */
+    template< typename F >
+    void parallel_for( size_t size, size_t threads, F f ) {
+        const size_t min_block = 4096;
+        threads = std::max< size_t >( 1, std::min( threads, size / min_block ) );
+        const size_t block = ( size + threads - 1 ) / threads;
+
+        std::vector< std::exception_ptr > errors( threads );
+        auto run = [&]( size_t t ) {
+            try {
+                f( std::min( t * block, size ), std::min( ( t + 1 ) * block, size ) );
+            } catch( ... ) {
+                errors[ t ] = std::current_exception();
+            }
+        };
+
+        std::vector< std::thread > workers;
+        for( size_t t = 1; t < threads; ++t )
+            workers.emplace_back( run, t );
+
+        run( 0 );
+        for( auto& worker : workers )
+            worker.join();
+
+        for( const auto& error : errors )
+            if( error ) std::rethrow_exception( error );
+    }
+
+}
+
+#endif
@@ -50,6 +50,10 @@ namespace Opm {
     }
 
 
+    static bool isOpen( const Completion& c ) {
+        return c.getState() != WellCompletion::StateEnum::SHUT;
+    }
+
     void CompletionSet::add( Completion completion ) {
         auto same = [&]( const Completion& c ) {
             return c.sameCoordinate( completion );
@@ -61,21 +65,18 @@ namespace Opm {
 
         if( prev != this->m_completions.end() ) {
             // update the completion, but preserve it's number
+            this->m_numOpen -= isOpen( *prev );
             *prev = Completion( completion, prev->complnum() );
+            this->m_numOpen += isOpen( *prev );
             return;
         }
 
+        this->m_numOpen += isOpen( completion );
         m_completions.emplace_back( completion );
     }
 
     bool CompletionSet::allCompletionsShut( ) const {
-        auto shut = []( const Completion& c ) {
-            return c.getState() == WellCompletion::StateEnum::SHUT;
-        };
-
-        return std::all_of( this->m_completions.begin(),
-                            this->m_completions.end(),
-                            shut );
+        return this->m_numOpen == 0;
     }
 
 
@@ -153,5 +154,6 @@ namespace Opm {
                                       m_completions.end(),
                                       [&grid](const Completion& c) { return !grid.cellActive(c.getI(), c.getJ(), c.getK()); });
         m_completions.erase(new_end, m_completions.end());
+        this->m_numOpen = std::count_if( m_completions.begin(), m_completions.end(), isOpen );
     }
 }
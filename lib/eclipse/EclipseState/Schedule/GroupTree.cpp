@@ -86,6 +86,16 @@ std::vector< std::string > GroupTree::children( const std::string& other_parent
     return kids;
 }
 
+std::map< std::string, std::vector< std::string > > GroupTree::children() const {
+    std::map< std::string, std::vector< std::string > > kids;
+    for( const auto& node : this->groups ) {
+        if( node.parent.empty() ) continue;
+        kids[ node.parent ].push_back( node.name );
+    }
+
+    return kids;
+}
+
 bool GroupTree::operator==( const GroupTree& rhs ) const {
     return this->groups.size() == rhs.groups.size()
         && std::equal( this->groups.begin(),
@@ -17,6 +17,7 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <stdexcept>
@@ -65,7 +66,6 @@ namespace Opm {
         m_rootGroupTree( this->m_timeMap, GroupTree{} ),
         m_oilvaporizationproperties( this->m_timeMap, OilVaporizationProperties{} ),
         m_events( this->m_timeMap ),
-        m_modifierDeck( this->m_timeMap, Deck{} ),
         m_tuning( this->m_timeMap ),
         m_messageLimits( this->m_timeMap ),
         m_phases(phases)
@@ -255,7 +255,13 @@ namespace Opm {
             else if (geoModifiers.find( keyword.name() ) != geoModifiers.end()) {
                 bool supported = geoModifiers.at( keyword.name() );
                 if (supported) {
-                    this->m_modifierDeck[ currentStep ].addKeyword( keyword );
+                    auto modifierDeck = this->m_modifierDeck.find( currentStep );
+                    if (modifierDeck == this->m_modifierDeck.end()) {
+                        modifierDeck = this->m_modifierDeck.emplace( currentStep, Deck{} ).first;
+                        modifierDeck->second.getActiveUnitSystem() = section.unitSystem();
+                    }
+
+                    modifierDeck->second.addKeyword( keyword );
                     m_events.addEvent( ScheduleEvents::GEO_MODIFIER , currentStep);
                 } else {
                     std::string msg = "OPM does not support grid property modifier " + keyword.name() + " in the Schedule section. Error at report: " + std::to_string( currentStep );
@@ -484,8 +490,10 @@ namespace Opm {
     }
 
     void Schedule::updateWellStatus( Well& well, size_t reportStep , WellCommon::StatusEnum status) {
-        if( well.setStatus( reportStep, status ) )
+        if( well.setStatus( reportStep, status ) ) {
             m_events.addEvent( ScheduleEvents::WELL_STATUS_CHANGE, reportStep );
+            this->m_changedWells.insert( well.name() );
+        }
     }
 
 
@@ -566,6 +574,7 @@ namespace Opm {
                 }
 
                 well->addCompletionSet(currentStep, newCompletionSet);
+                this->m_changedWells.insert( well->name() );
             }
         }
     }
@@ -820,6 +829,7 @@ namespace Opm {
                     new_completions.add( new_completion( completion ) );
 
                 well->addCompletionSet( timestep, new_completions );
+                this->m_changedWells.insert( well->name() );
             }
         }
     }
@@ -902,6 +912,7 @@ namespace Opm {
                     new_completions.add( new_completion( c ) );
 
                 well->addCompletionSet( currentStep, new_completions );
+                this->m_changedWells.insert( well->name() );
                 m_events.addEvent( ScheduleEvents::COMPLETION_CHANGE, currentStep );
             }
         }
@@ -1271,6 +1282,7 @@ namespace Opm {
         for( const auto pair : completions ) {
             auto& well = this->m_wells.get( pair.first );
             well.addCompletions( currentStep, pair.second );
+            this->m_changedWells.insert( well.name() );
             if (well.getCompletions( currentStep ).allCompletionsShut()) {
                 std::string msg =
                         "All completions in well " + well.name() + " is shut at " + std::to_string ( m_timeMap.getTimePassedUntil(currentStep) / (60*60*24) ) + " days. \n" +
@@ -1303,6 +1315,7 @@ namespace Opm {
         const CompletionSet new_completion_set = updatingCompletionsWithSegments(keyword, completion_set, segment_set);
 
         well.addCompletionSet(currentStep, new_completion_set);
+        this->m_changedWells.insert( well.name() );
     }
 
     void Schedule::handleWGRUPCON( const DeckKeyword& keyword, size_t currentStep) {
@@ -1424,7 +1437,9 @@ namespace Opm {
                   timeStep,
                   wellCompletionOrder, allowCrossFlow, automaticShutIn);
 
+        m_wellIndex.emplace( wellName, m_wells.size() );
         m_wells.insert( wellName, well );
+        m_changedWells.insert( wellName );
         m_events.addEvent( ScheduleEvents::NEW_WELL , timeStep );
     }
 
@@ -1445,30 +1460,43 @@ namespace Opm {
     }
 
     /*
-      This will recursively go all the way down through the group tree
-      until the well leaf-nodes are encountered.
+      This will go all the way down through the group tree until the
+      well leaf-nodes are encountered; the groups are visited depth
+      first in the order of GroupTree::children().
     */
     std::vector< const Well* > Schedule::getWells(const std::string& group_name, size_t timeStep) const {
         if (!hasGroup(group_name))
             throw std::invalid_argument("No such group: " + group_name);
         {
-            const auto& group = getGroup( group_name );
             std::vector<const Well*> wells;
-
-            if (group.hasBeenDefined( timeStep )) {
-                const GroupTree& group_tree = getGroupTree( timeStep );
-                const auto& child_groups = group_tree.children( group_name );
-
-                if (child_groups.size()) {
-                    for (const auto& child : child_groups) {
-                        const auto& child_wells = getWells( child, timeStep );
-                        wells.insert( wells.end() , child_wells.begin() , child_wells.end());
-                    }
-                } else {
-                    for (const auto& well_name : group.getWells( timeStep )) {
-                        wells.push_back( getWell( well_name ));
-                    }
+            if (!getGroup( group_name ).hasBeenDefined( timeStep ))
+                return wells;
+
+            const GroupTree& group_tree = getGroupTree( timeStep );
+            if (!group_tree.exists( group_name ))
+                throw std::out_of_range( "Node '" + group_name + "' does not exist." );
+
+            const auto children = group_tree.children();
+            std::vector< std::string > stack = { group_name };
+            while (!stack.empty()) {
+                const auto name = stack.back();
+                stack.pop_back();
+
+                if (!hasGroup(name))
+                    throw std::invalid_argument("No such group: " + name);
+
+                const auto& group = getGroup( name );
+                if (!group.hasBeenDefined( timeStep ))
+                    continue;
+
+                const auto child_groups = children.find( name );
+                if (child_groups != children.end()) {
+                    stack.insert( stack.end(), child_groups->second.rbegin(), child_groups->second.rend() );
+                    continue;
                 }
+
+                for (const auto& well_name : group.getWells( timeStep ))
+                    wells.push_back( getWell( well_name ));
             }
             return wells;
         }
@@ -1531,13 +1559,31 @@ namespace Opm {
             return { std::addressof( m_wells.get( wellNamePattern ) ) };
         }
 
-        std::vector< Well* > wells;
-        for( auto& well : this->m_wells ) {
-            if( Well::wellNameInWellNamePattern( well.name(), wellNamePattern ) ) {
-                wells.push_back( std::addressof( well ) );
-            }
+        /*
+          Only the wells whose names start with the literal prefix of
+          the pattern can match, and they form a range of the sorted
+          well index. When the pattern is just that prefix and the
+          trailing '*' every well in the range matches.
+        */
+        const auto literal = wellNamePattern.find_first_of( "*?[\\" );
+        const auto prefix = wellNamePattern.substr( 0, literal );
+        const bool prefix_only = !wellNamePattern.empty() && literal == wellNamePattern.size() - 1;
+
+        std::vector< size_t > matches;
+        for( auto it = this->m_wellIndex.lower_bound( prefix );
+             it != this->m_wellIndex.end() && it->first.compare( 0, prefix.size(), prefix ) == 0;
+             ++it ) {
+            if( prefix_only || Well::wellNameInWellNamePattern( it->first, wellNamePattern ) )
+                matches.push_back( it->second );
         }
 
+        std::sort( matches.begin(), matches.end() );
+
+        std::vector< Well* > wells;
+        wells.reserve( matches.size() );
+        for( const auto index : matches )
+            wells.push_back( std::addressof( this->m_wells.get( index ) ) );
+
         return wells;
     }
 
@@ -1646,7 +1692,15 @@ namespace Opm {
     }
 
     const Deck& Schedule::getModifierDeck(size_t timeStep) const {
-        return m_modifierDeck.iget( timeStep );
+        if (timeStep >= this->m_timeMap.size())
+            throw std::out_of_range("Invalid report step: " + std::to_string( timeStep ));
+
+        const auto modifierDeck = this->m_modifierDeck.find( timeStep );
+        if (modifierDeck != this->m_modifierDeck.end())
+            return modifierDeck->second;
+
+        static const Deck empty;
+        return empty;
     }
 
     const MessageLimits& Schedule::getMessageLimits() const {
@@ -1678,12 +1732,20 @@ namespace Opm {
         return false;
     }
 
+    /*
+      A well which had all its completions shut at the previous check
+      has been shut, so only the wells whose completions or status
+      have changed since then need to be looked at.
+    */
     void Schedule::checkIfAllConnectionsIsShut(size_t timestep) {
-        for( auto& well : this->m_wells ) {
+        for( const auto& well_name : this->m_changedWells ) {
+            auto& well = this->m_wells.get( well_name );
             const auto& completions = well.getCompletions(timestep);
             if( completions.allCompletionsShut() )
                 this->updateWellStatus( well, timestep, WellCommon::StatusEnum::SHUT);
         }
+
+        this->m_changedWells.clear();
     }
 
 
@@ -579,7 +579,10 @@ namespace Opm {
     void Well::filterCompletions(const EclipseGrid& grid) {
         /*
           The m_completions member variable is DynamicState<CompletionSet>
-          instance, hence this for loop is over all timesteps.
+          instance, and the loop is over its distinct values, i.e. once
+          for every timestep where the completions change, not once for
+          every timestep. Shared values are cloned by begin(), so every
+          value is filtered exactly once.
         */
         for (auto& completions : m_completions)
             completions.filter(grid);
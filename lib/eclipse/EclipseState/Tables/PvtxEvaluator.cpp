@@ -0,0 +1,216 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <opm/parser/eclipse/EclipseState/Tables/PvtxEvaluator.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/PvtxTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/SimpleTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableColumn.hpp>
+
+namespace Opm {
+
+    namespace {
+
+        /* 1/(v[i+1] - v[i]) for every interval, and a trailing zero */
+        void appendInverseWidths( const std::vector< double >& values,
+                                  size_t begin, size_t end,
+                                  std::vector< double >& inverseWidth ) {
+            for (size_t i = begin; i + 1 < end; ++i)
+                inverseWidth.push_back( 1.0 / (values[i + 1] - values[i]) );
+
+            inverseWidth.push_back( 0 );
+        }
+
+    }
+
+
+    PvtxEvaluator::PvtxEvaluator( const PvtxTable& table ) {
+        if (table.size() == 0)
+            throw std::invalid_argument("Can not create an evaluator for an empty table");
+
+        for (size_t index = 0; index < table.size(); ++index)
+            m_outer.push_back( table.getArgValue( index ) );
+        appendInverseWidths( m_outer, 0, m_outer.size(), m_outerInverseWidth );
+
+        const auto& first = table.getUnderSaturatedTable( 0 );
+        for (size_t columnIndex = 1; columnIndex < first.numColumns(); ++columnIndex)
+            m_columnNames.push_back( first.getColumn( columnIndex ).name() );
+
+        m_values.resize( m_columnNames.size() );
+        m_offset.push_back( 0 );
+        for (const auto& underSaturatedTable : table) {
+            const auto& argColumn = underSaturatedTable.getColumn( 0 );
+            if (argColumn.size() == 0 || argColumn.hasDefault())
+                throw std::invalid_argument("The undersaturated tables must have a complete argument column");
+
+            const size_t begin = m_inner.size();
+            m_inner.insert( m_inner.end(), argColumn.begin(), argColumn.end() );
+            appendInverseWidths( m_inner, begin, m_inner.size(), m_innerInverseWidth );
+            m_decreasing.push_back( argColumn.front() > argColumn.back() );
+
+            for (size_t columnIndex = 0; columnIndex < m_values.size(); ++columnIndex) {
+                const auto& valueColumn = underSaturatedTable.getColumn( columnIndex + 1 );
+                if (valueColumn.hasDefault())
+                    throw std::invalid_argument("The undersaturated tables can not have defaulted values in column: " + valueColumn.name());
+
+                m_values[columnIndex].insert( m_values[columnIndex].end(),
+                                              valueColumn.begin(), valueColumn.end() );
+            }
+
+            m_offset.push_back( m_inner.size() );
+        }
+    }
+
+
+    size_t PvtxEvaluator::column( const std::string& name ) const {
+        const auto iter = std::find( m_columnNames.begin(), m_columnNames.end(), name );
+        if (iter == m_columnNames.end())
+            throw std::invalid_argument("No value column: " + name + " in the table");
+
+        return iter - m_columnNames.begin();
+    }
+
+
+    void PvtxEvaluator::assertColumn( size_t column ) const {
+        if (column >= m_values.size())
+            throw std::invalid_argument("Invalid column handle: " + std::to_string( column ));
+    }
+
+
+    /*
+      Same bracketing as TableColumn::lookup(): an argument beyond the
+      largest or smallest value is clamped to that point, and a NaN
+      argument, which fails both clamp tests, is put in the first
+      interval with a NaN weight.
+    */
+    PvtxEvaluator::Bracket PvtxEvaluator::find( const double* values, const double* inverseWidth,
+                                                size_t size, bool decreasing, double arg ) {
+        if (std::isnan( arg ))
+            return Bracket{ 0, arg, inverseWidth[0] };
+
+        const size_t maxIndex = decreasing ? 0 : size - 1;
+        const size_t minIndex = decreasing ? size - 1 : 0;
+
+        if (arg >= values[maxIndex])
+            return Bracket{ maxIndex, 0.0, 0.0 };
+
+        if (arg <= values[minIndex])
+            return Bracket{ minIndex, 0.0, 0.0 };
+
+        const double* upper;
+        if (decreasing)
+            upper = std::partition_point( values, values + size,
+                                          [arg]( double value ) { return value >= arg; });
+        else
+            upper = std::lower_bound( values, values + size, arg );
+
+        const size_t index = (upper - values) - 1;
+        return Bracket{ index, (arg - values[index]) * inverseWidth[index], inverseWidth[index] };
+    }
+
+
+    double PvtxEvaluator::interpolate( size_t table, size_t column, double innerArg, double* dInner ) const {
+        const size_t offset = m_offset[table];
+        const auto bracket = find( m_inner.data() + offset,
+                                   m_innerInverseWidth.data() + offset,
+                                   m_offset[table + 1] - offset,
+                                   m_decreasing[table],
+                                   innerArg );
+
+        const double* values = m_values[column].data() + offset + bracket.index;
+        if (bracket.inverseWidth == 0) {
+            if (dInner)
+                *dInner = 0;
+            return values[0];
+        }
+
+        if (dInner)
+            *dInner = (values[1] - values[0]) * bracket.inverseWidth;
+
+        return (1 - bracket.weight2) * values[0] + bracket.weight2 * values[1];
+    }
+
+
+    double PvtxEvaluator::interpolate( size_t column, double outerArg, double innerArg,
+                                       double* dOuter, double* dInner ) const {
+        const auto bracket = find( m_outer.data(), m_outerInverseWidth.data(),
+                                   m_outer.size(), false, outerArg );
+
+        const double value1 = interpolate( bracket.index, column, innerArg, dInner );
+        if (bracket.inverseWidth == 0) {
+            if (dOuter)
+                *dOuter = 0;
+            return value1;
+        }
+
+        double dInner2 = 0;
+        const double value2 = interpolate( bracket.index + 1, column, innerArg, dInner ? &dInner2 : nullptr );
+        const double weight2 = bracket.weight2;
+
+        if (dOuter)
+            *dOuter = (value2 - value1) * bracket.inverseWidth;
+
+        if (dInner)
+            *dInner = (1 - weight2) * *dInner + weight2 * dInner2;
+
+        return (1 - weight2) * value1 + weight2 * value2;
+    }
+
+
+    double PvtxEvaluator::evaluate( size_t column, double outerArg, double innerArg ) const {
+        assertColumn( column );
+        return interpolate( column, outerArg, innerArg, nullptr, nullptr );
+    }
+
+
+    double PvtxEvaluator::evaluate( size_t column, double outerArg, double innerArg,
+                                    double& dOuter, double& dInner ) const {
+        assertColumn( column );
+        return interpolate( column, outerArg, innerArg, &dOuter, &dInner );
+    }
+
+
+    std::vector< double > PvtxEvaluator::evaluate( size_t column,
+                                                   const std::vector< double >& outerArgs,
+                                                   const std::vector< double >& innerArgs,
+                                                   std::vector< double >* dOuter,
+                                                   std::vector< double >* dInner ) const {
+        assertColumn( column );
+        if (outerArgs.size() != innerArgs.size())
+            throw std::invalid_argument("The outer and inner arguments must have the same size");
+
+        const size_t size = outerArgs.size();
+        std::vector< double > values( size );
+        if (dOuter)
+            dOuter->resize( size );
+        if (dInner)
+            dInner->resize( size );
+
+        for (size_t i = 0; i < size; ++i)
+            values[i] = interpolate( column, outerArgs[i], innerArgs[i],
+                                     dOuter ? dOuter->data() + i : nullptr,
+                                     dInner ? dInner->data() + i : nullptr );
+
+        return values;
+    }
+
+}
@@ -18,6 +18,7 @@
  */
 #include <stdexcept>
 #include <algorithm>
+#include <cmath>
 
 #include <opm/parser/eclipse/EclipseState/Tables/ColumnSchema.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableColumn.hpp>
@@ -27,7 +28,8 @@
 namespace Opm {
 
     TableColumn::TableColumn(const ColumnSchema& schema) :
-        m_schema( schema )
+        m_schema( schema ),
+        m_name( schema.name() )
     {
         m_defaultCount = 0;
     }
@@ -82,6 +84,14 @@ namespace Opm {
         assertUpdate( m_values.size() , value );
         m_values.push_back( value );
         m_default.push_back( false );
+
+        if (!hasDefault()) {
+            const size_t index = m_values.size() - 1;
+            if (index == 0 || value < m_values[m_minIndex])
+                m_minIndex = index;
+            if (index == 0 || value > m_values[m_maxIndex])
+                m_maxIndex = index;
+        }
     }
 
 
@@ -102,11 +112,42 @@ namespace Opm {
 
     void TableColumn::updateValue(  size_t index , double value ) {
         assertUpdate( index , value );
+        const double oldValue = m_values[index];
+        const bool wasDefault = m_default[index];
         m_values[index] = value;
-        if (m_default[index]) {
+        if (wasDefault) {
             m_default[index] = false;
             m_defaultCount -= 1;
         }
+
+        if (hasDefault())
+            return;
+
+        /*
+          The bounds are only maintained for a column without defaults;
+          rescan when the last default is filled, or when the current
+          min or max value moves inwards. Otherwise the bounds can be
+          updated in place.
+        */
+        if (wasDefault ||
+            (index == m_minIndex && value > oldValue) ||
+            (index == m_maxIndex && value < oldValue)) {
+            updateBounds();
+            return;
+        }
+
+        if (value < m_values[m_minIndex])
+            m_minIndex = index;
+        if (value > m_values[m_maxIndex])
+            m_maxIndex = index;
+    }
+
+
+    void TableColumn::updateBounds() {
+        const auto min_iter = std::min_element( m_values.begin() , m_values.end());
+        const auto max_iter = std::max_element( m_values.begin() , m_values.end());
+        m_minIndex = min_iter - m_values.begin();
+        m_maxIndex = max_iter - m_values.begin();
     }
 
     bool TableColumn::defaultApplied(size_t index) const {
@@ -139,7 +180,7 @@ namespace Opm {
         if (hasDefault())
             throw std::invalid_argument("Can not lookup elements in a column with defaulted values.");
         if (m_values.size() > 0)
-            return *std::max_element( m_values.begin() , m_values.end());
+            return m_values[m_maxIndex];
         else
             throw std::invalid_argument("Can not find max in empty column");
     }
@@ -149,7 +190,7 @@ namespace Opm {
         if (hasDefault())
             throw std::invalid_argument("Can not lookup elements in a column with defaulted values.");
         if (m_values.size() > 0)
-            return *std::min_element( m_values.begin() , m_values.end());
+            return m_values[m_minIndex];
         else
             throw std::invalid_argument("Can not find max in empty column");
     }
@@ -170,7 +211,7 @@ namespace Opm {
     }
 
 
-    TableIndex TableColumn::lookup( double argValue ) const {
+    void TableColumn::assertLookup() const {
         if (!m_schema.lookupValid( ))
             throw std::invalid_argument("Must have an ordered column to perform table argument lookup.");
 
@@ -179,47 +220,55 @@ namespace Opm {
 
         if (hasDefault())
             throw std::invalid_argument("Can not lookup elements in a column with defaulted values.");
+    }
 
-        if (argValue >= max()) {
-            const auto max_iter = std::max_element( m_values.begin() , m_values.end());
-            const size_t max_index = max_iter - m_values.begin();
-            return TableIndex( max_index , 1.0 );
-        }
 
-        if (argValue <= min()) {
-            const auto min_iter = std::min_element( m_values.begin() , m_values.end());
-            const size_t min_index = min_iter - m_values.begin();
-            return TableIndex( min_index , 1.0 );
-        }
+    /*
+      Assumes assertLookup() has passed. Arguments outside the range
+      of the column are clamped to the end points, otherwise the
+      interval [i, i+1] containing the argument is found with a
+      binary search. A NaN argument fails both clamp tests and is
+      returned as TableIndex(0, NaN), like the old linear lookup did.
+    */
+    TableIndex TableColumn::bracket( double argValue ) const {
+        if (std::isnan( argValue ))
+            return TableIndex( 0 , argValue );
 
-        {
-            bool isDescending = m_schema.isDecreasing( );
-            size_t lowIntervalIdx = 0;
-            size_t intervalIdx = (size() - 1)/2;
-            size_t highIntervalIdx = size() - 1;
-            double weight1;
-
-            while (lowIntervalIdx + 1 < highIntervalIdx) {
-                if (isDescending) {
-                    if (m_values[intervalIdx] < argValue)
-                        highIntervalIdx = intervalIdx;
-                    else
-                        lowIntervalIdx = intervalIdx;
-                }
-                else {
-                    if (m_values[intervalIdx] < argValue)
-                        lowIntervalIdx = intervalIdx;
-                    else
-                        highIntervalIdx = intervalIdx;
-                }
+        if (argValue >= m_values[m_maxIndex])
+            return TableIndex( m_maxIndex , 1.0 );
 
-                intervalIdx = (highIntervalIdx + lowIntervalIdx)/2;
-            }
+        if (argValue <= m_values[m_minIndex])
+            return TableIndex( m_minIndex , 1.0 );
 
-            weight1 = 1 - (argValue - m_values[intervalIdx])/(m_values[intervalIdx + 1] - m_values[intervalIdx]);
+        std::vector<double>::const_iterator upper;
+        if (m_schema.isDecreasing( ))
+            upper = std::partition_point( m_values.begin() , m_values.end(),
+                                          [argValue]( double value ) { return value >= argValue; });
+        else
+            upper = std::lower_bound( m_values.begin() , m_values.end() , argValue );
 
-            return TableIndex( intervalIdx , weight1 );
-        }
+        const size_t intervalIdx = (upper - m_values.begin()) - 1;
+        const double weight1 = 1 - (argValue - m_values[intervalIdx])/(m_values[intervalIdx + 1] - m_values[intervalIdx]);
+
+        return TableIndex( intervalIdx , weight1 );
+    }
+
+
+    TableIndex TableColumn::lookup( double argValue ) const {
+        assertLookup();
+        return bracket( argValue );
+    }
+
+
+    std::vector<TableIndex> TableColumn::lookup( const std::vector<double>& argValues ) const {
+        assertLookup();
+
+        std::vector<TableIndex> indices;
+        indices.reserve( argValues.size() );
+        for (const double argValue : argValues)
+            indices.push_back( bracket( argValue ) );
+
+        return indices;
     }
 
     std::vector<double>::const_iterator TableColumn::begin() const {
@@ -251,6 +300,16 @@ namespace Opm {
     }
 
 
+    std::vector<double> TableColumn::eval( const std::vector<TableIndex>& indices) const {
+        std::vector<double> values;
+        values.reserve( indices.size() );
+        for (const auto& index : indices)
+            values.push_back( eval( index ) );
+
+        return values;
+    }
+
+
     TableColumn& TableColumn::operator= (const TableColumn& other) {
         if (this != &other) {
             m_schema = other.m_schema;
@@ -258,6 +317,8 @@ namespace Opm {
             m_values = other.m_values;
             m_default = other.m_default;
             m_defaultCount = other.m_defaultCount;
+            m_minIndex = other.m_minIndex;
+            m_maxIndex = other.m_maxIndex;
         }
         return *this;
     }
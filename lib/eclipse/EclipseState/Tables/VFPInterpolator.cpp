@@ -0,0 +1,322 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+#include <opm/parser/eclipse/EclipseState/Tables/VFPInjTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/VFPInterpolator.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/VFPProdTable.hpp>
+
+
+namespace Opm {
+
+namespace {
+
+/*
+ * Multilinear interpolation over N axes. Corner c of the hypercube
+ * holding the argument is found at data[offset(c)], where bit k of c
+ * selects the upper point along axis k, which is steps[k] further into
+ * the data. The corners are collapsed one axis at a time, starting with
+ * axis 0. If derivatives is not null, derivatives[k] is set to the
+ * partial derivative along axis k.
+ */
+template< size_t N >
+double interpolate( const double* data,
+                    const std::array< size_t, N >& steps,
+                    const std::array< VFPAxis::Bracket, N >& brackets,
+                    double* derivatives ) {
+    constexpr size_t corners = size_t( 1 ) << N;
+    constexpr size_t half = corners / 2;
+
+    /* offsets of the lower corners along axis 0 */
+    std::array< size_t, half > offset;
+    offset[ 0 ] = 0;
+    for( size_t k = 1; k < N; ++k ) {
+        const size_t n = size_t( 1 ) << (k - 1);
+        for( size_t c = 0; c < n; ++c )
+            offset[ c + n ] = offset[ c ] + steps[ k ];
+    }
+
+    /* the first axis is interpolated for all the corner pairs at once */
+    std::array< double, half > values;
+    std::array< std::array< double, half >, N > d;
+    const double t0 = brackets[ 0 ].factor;
+    const double w0 = brackets[ 0 ].inverseWidth;
+    for( size_t c = 0; c < half; ++c ) {
+        const double lo = data[ offset[ c ] ];
+        const double hi = data[ offset[ c ] + steps[ 0 ] ];
+        values[ c ] = lo + t0 * (hi - lo);
+        d[ 0 ][ c ] = (hi - lo) * w0;
+    }
+
+    for( size_t k = 1; k < N; ++k ) {
+        const size_t n = corners >> (k + 1);
+        const double t = brackets[ k ].factor;
+        const double w = brackets[ k ].inverseWidth;
+
+        for( size_t c = 0; c < n; ++c ) {
+            const double lo = values[ 2 * c ];
+            const double hi = values[ 2 * c + 1 ];
+
+            if( derivatives ) {
+                for( size_t j = 0; j < k; ++j )
+                    d[ j ][ c ] = d[ j ][ 2 * c ] + t * (d[ j ][ 2 * c + 1 ] - d[ j ][ 2 * c ]);
+                d[ k ][ c ] = (hi - lo) * w;
+            }
+
+            values[ c ] = lo + t * (hi - lo);
+        }
+    }
+
+    if( derivatives ) {
+        for( size_t k = 0; k < N; ++k )
+            derivatives[ k ] = d[ k ][ 0 ];
+    }
+
+    return values[ 0 ];
+}
+
+size_t step( const VFPAxis& axis, size_t stride ) {
+    return axis.size() > 1 ? stride : 0;
+}
+
+template< typename... Args >
+size_t commonSize( const std::vector< double >& first, const Args&... rest ) {
+    for( const auto size : { rest.size()... } ) {
+        if( size != first.size() )
+            throw std::invalid_argument("All the VFP arguments must have the same size");
+    }
+
+    return first.size();
+}
+
+}
+
+
+VFPAxis::VFPAxis(const std::vector<double>& values) :
+    m_values( values )
+{
+    if (m_values.empty())
+        throw std::invalid_argument("A VFP axis must have at least one value");
+
+    for (size_t i = 0; i + 1 < m_values.size(); ++i) {
+        if (!(m_values[i] < m_values[i + 1]))
+            throw std::invalid_argument("The values of a VFP axis must be strictly increasing");
+
+        m_inverseWidth.push_back( 1.0 / (m_values[i + 1] - m_values[i]) );
+    }
+}
+
+
+size_t VFPAxis::size() const {
+    return m_values.size();
+}
+
+
+VFPAxis::Bracket VFPAxis::find(double x) const {
+    if (m_values.size() < 2)
+        return Bracket{ 0, 0.0, 0.0 };
+
+    const auto upper = std::upper_bound( m_values.begin() + 1, m_values.end() - 1, x );
+    const size_t index = (upper - m_values.begin()) - 1;
+    const double inverseWidth = m_inverseWidth[index];
+
+    return Bracket{ index, (x - m_values[index]) * inverseWidth, inverseWidth };
+}
+
+
+
+VFPProdInterpolator::VFPProdInterpolator(const VFPProdTable& table) :
+    m_flo( table.getFloAxis() ),
+    m_thp( table.getTHPAxis() ),
+    m_wfr( table.getWFRAxis() ),
+    m_gfr( table.getGFRAxis() ),
+    m_alq( table.getALQAxis() )
+{
+    const auto& data = table.getTable();
+    const size_t nflo = m_flo.size();
+    const size_t nthp = m_thp.size();
+    const size_t nwfr = m_wfr.size();
+    const size_t ngfr = m_gfr.size();
+    const size_t nalq = m_alq.size();
+
+    const auto shape = data.shape();
+    if (shape[0] != nthp || shape[1] != nwfr || shape[2] != ngfr || shape[3] != nalq || shape[4] != nflo)
+        throw std::invalid_argument("The VFPPROD data does not match the size of the axes");
+
+    m_flo_step = step( m_flo, 1 );
+    m_thp_step = step( m_thp, nflo );
+    m_alq_step = step( m_alq, nthp * nflo );
+    m_gfr_step = step( m_gfr, nalq * nthp * nflo );
+    m_wfr_step = step( m_wfr, ngfr * nalq * nthp * nflo );
+
+    m_data.reserve( data.num_elements() );
+    for (size_t w = 0; w < nwfr; ++w)
+        for (size_t g = 0; g < ngfr; ++g)
+            for (size_t a = 0; a < nalq; ++a)
+                for (size_t t = 0; t < nthp; ++t)
+                    for (size_t f = 0; f < nflo; ++f)
+                        m_data.push_back( data[t][w][g][a][f] );
+}
+
+
+double VFPProdInterpolator::interpolate(double flo, double thp, double wfr, double gfr, double alq,
+                                       VFPEvaluation* evaluation) const {
+    const std::array< VFPAxis::Bracket, 5 > brackets = {{
+        m_flo.find( flo ), m_thp.find( thp ), m_alq.find( alq ), m_gfr.find( gfr ), m_wfr.find( wfr )
+    }};
+    const std::array< size_t, 5 > steps = {{
+        m_flo_step, m_thp_step, m_alq_step, m_gfr_step, m_wfr_step
+    }};
+
+    const size_t base = (((brackets[4].index * m_gfr.size()
+                           + brackets[3].index) * m_alq.size()
+                           + brackets[2].index) * m_thp.size()
+                           + brackets[1].index) * m_flo.size()
+                           + brackets[0].index;
+
+    if (!evaluation)
+        return Opm::interpolate< 5 >( m_data.data() + base, steps, brackets, nullptr );
+
+    double derivatives[5];
+    evaluation->value = Opm::interpolate< 5 >( m_data.data() + base, steps, brackets, derivatives );
+    evaluation->dflo = derivatives[0];
+    evaluation->dthp = derivatives[1];
+    evaluation->dalq = derivatives[2];
+    evaluation->dgfr = derivatives[3];
+    evaluation->dwfr = derivatives[4];
+    return evaluation->value;
+}
+
+
+double VFPProdInterpolator::bhp(double flo, double thp, double wfr, double gfr, double alq) const {
+    return interpolate( flo, thp, wfr, gfr, alq, nullptr );
+}
+
+
+VFPEvaluation VFPProdInterpolator::evaluate(double flo, double thp, double wfr, double gfr, double alq) const {
+    VFPEvaluation evaluation;
+    interpolate( flo, thp, wfr, gfr, alq, &evaluation );
+    return evaluation;
+}
+
+
+std::vector<double> VFPProdInterpolator::bhp(const std::vector<double>& flo,
+                                             const std::vector<double>& thp,
+                                             const std::vector<double>& wfr,
+                                             const std::vector<double>& gfr,
+                                             const std::vector<double>& alq) const {
+    const size_t size = commonSize( flo, thp, wfr, gfr, alq );
+    std::vector<double> values( size );
+    for (size_t i = 0; i < size; ++i)
+        values[i] = interpolate( flo[i], thp[i], wfr[i], gfr[i], alq[i], nullptr );
+
+    return values;
+}
+
+
+std::vector<VFPEvaluation> VFPProdInterpolator::evaluate(const std::vector<double>& flo,
+                                                         const std::vector<double>& thp,
+                                                         const std::vector<double>& wfr,
+                                                         const std::vector<double>& gfr,
+                                                         const std::vector<double>& alq) const {
+    const size_t size = commonSize( flo, thp, wfr, gfr, alq );
+    std::vector<VFPEvaluation> evaluations( size );
+    for (size_t i = 0; i < size; ++i)
+        interpolate( flo[i], thp[i], wfr[i], gfr[i], alq[i], &evaluations[i] );
+
+    return evaluations;
+}
+
+
+
+VFPInjInterpolator::VFPInjInterpolator(const VFPInjTable& table) :
+    m_flo( table.getFloAxis() ),
+    m_thp( table.getTHPAxis() )
+{
+    const auto& data = table.getTable();
+    const size_t nflo = m_flo.size();
+    const size_t nthp = m_thp.size();
+
+    const auto shape = data.shape();
+    if (shape[0] != nthp || shape[1] != nflo)
+        throw std::invalid_argument("The VFPINJ data does not match the size of the axes");
+
+    m_flo_step = step( m_flo, 1 );
+    m_thp_step = step( m_thp, nflo );
+
+    m_data.reserve( data.num_elements() );
+    for (size_t t = 0; t < nthp; ++t)
+        for (size_t f = 0; f < nflo; ++f)
+            m_data.push_back( data[t][f] );
+}
+
+
+double VFPInjInterpolator::interpolate(double flo, double thp, VFPEvaluation* evaluation) const {
+    const std::array< VFPAxis::Bracket, 2 > brackets = {{ m_flo.find( flo ), m_thp.find( thp ) }};
+    const std::array< size_t, 2 > steps = {{ m_flo_step, m_thp_step }};
+    const size_t base = brackets[1].index * m_flo.size() + brackets[0].index;
+
+    if (!evaluation)
+        return Opm::interpolate< 2 >( m_data.data() + base, steps, brackets, nullptr );
+
+    double derivatives[2];
+    evaluation->value = Opm::interpolate< 2 >( m_data.data() + base, steps, brackets, derivatives );
+    evaluation->dflo = derivatives[0];
+    evaluation->dthp = derivatives[1];
+    return evaluation->value;
+}
+
+
+double VFPInjInterpolator::bhp(double flo, double thp) const {
+    return interpolate( flo, thp, nullptr );
+}
+
+
+VFPEvaluation VFPInjInterpolator::evaluate(double flo, double thp) const {
+    VFPEvaluation evaluation;
+    interpolate( flo, thp, &evaluation );
+    return evaluation;
+}
+
+
+std::vector<double> VFPInjInterpolator::bhp(const std::vector<double>& flo,
+                                            const std::vector<double>& thp) const {
+    const size_t size = commonSize( flo, thp );
+    std::vector<double> values( size );
+    for (size_t i = 0; i < size; ++i)
+        values[i] = interpolate( flo[i], thp[i], nullptr );
+
+    return values;
+}
+
+
+std::vector<VFPEvaluation> VFPInjInterpolator::evaluate(const std::vector<double>& flo,
+                                                        const std::vector<double>& thp) const {
+    const size_t size = commonSize( flo, thp );
+    std::vector<VFPEvaluation> evaluations( size );
+    for (size_t i = 0; i < size; ++i)
+        interpolate( flo[i], thp[i], &evaluations[i] );
+
+    return evaluations;
+}
+
+} //Namespace opm
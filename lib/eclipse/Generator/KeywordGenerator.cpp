@@ -29,6 +29,7 @@
 #include <opm/json/JsonObject.hpp>
 #include <opm/parser/eclipse/Generator/KeywordGenerator.hpp>
 #include <opm/parser/eclipse/Generator/KeywordLoader.hpp>
+#include <opm/parser/eclipse/Parser/DeckNameHash.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
 
 
@@ -102,19 +103,44 @@ namespace Opm {
     }
 
 
-    bool KeywordGenerator::updateSource(const KeywordLoader& loader , const std::string& sourceFile ) const {
-        std::stringstream newSource;
-        newSource << sourceHeader << std::endl;
-
-        newSource << "void addDefaultKeywords(Parser& p);"  << std::endl
-                  << "void addDefaultKeywords(Parser& p) {" << std::endl;
+    /*
+     * The perfect hash of the deck names of all the keywords, see
+     * DeckNameHash, which Parser uses to look up keywords.
+     */
+    std::string KeywordGenerator::deckNameHash( const KeywordLoader& loader ) {
+        std::vector< std::string > names;
         for( auto iter = loader.keyword_begin(); iter != loader.keyword_end(); ++iter ) {
-            newSource << "p.addKeyword< ParserKeywords::"
-                      << iter->second->className()
-                      << " >();" << std::endl;
+            const auto& keyword = *iter->second;
+            names.insert( names.end(), keyword.deckNamesBegin(), keyword.deckNamesEnd() );
         }
 
-        newSource << "}" << std::endl;
+        const auto table = DeckNameHash::build( names );
+
+        std::stringstream stream;
+        stream << "namespace {" << std::endl
+               << "const uint32_t deck_name_seeds[] = {";
+        for( size_t i = 0; i < table.seeds.size(); ++i )
+            stream << ( i % 16 == 0 ? "\n" : " " ) << table.seeds[ i ] << ",";
+
+        stream << "\n};" << std::endl
+               << "const uint64_t deck_name_keys[] = {";
+        for( size_t i = 0; i < table.keys.size(); ++i )
+            stream << ( i % 4 == 0 ? "\n" : " " ) << table.keys[ i ] << "ULL,";
+
+        stream << "\n};" << std::endl
+               << "}" << std::endl << std::endl
+               << "const DeckNameHash& Parser::defaultDeckNames() {" << std::endl
+               << "static const DeckNameHash hash( deck_name_seeds, " << table.seeds.size() << "," << std::endl
+               << "                                deck_name_keys, " << table.keys.size() << " );" << std::endl
+               << "return hash;" << std::endl
+               << "}" << std::endl << std::endl;
+
+        return stream.str();
+    }
+
+    bool KeywordGenerator::updateSource(const KeywordLoader& loader , const std::string& sourceFile ) const {
+        std::stringstream newSource;
+        newSource << sourceHeader << std::endl;
 
         for (auto iter = loader.keyword_begin(); iter != loader.keyword_end(); ++iter) {
             std::shared_ptr<ParserKeyword> keyword = (*iter).second;
@@ -123,8 +149,38 @@ namespace Opm {
 
         newSource << "}" << std::endl;
 
+        newSource << deckNameHash( loader );
+
+        /*
+         * The keywords are registered by their deck names, and only
+         * constructed when they are first looked up.
+         */
+        newSource << "namespace {" << std::endl
+                  << "template< typename T >" << std::endl
+                  << "std::unique_ptr< const ParserKeyword > create() {" << std::endl
+                  << "return std::unique_ptr< const ParserKeyword >( new T() );" << std::endl
+                  << "}" << std::endl << std::endl
+                  << "const Parser::KeywordFactory default_keywords[] = {" << std::endl;
+
+        for( auto iter = loader.keyword_begin(); iter != loader.keyword_end(); ++iter ) {
+            const auto& keyword = *iter->second;
+            std::string names;
+            for( auto name = keyword.deckNamesBegin(); name != keyword.deckNamesEnd(); ++name )
+                names += ( names.empty() ? "" : " " ) + *name;
+
+            newSource << "{ \"" << names << "\", "
+                      << ( keyword.hasMatchRegex() ? "true" : "false" ) << ", "
+                      << "&create< ParserKeywords::" << keyword.className() << " >, "
+                      << keyword.definitionHash() << "ULL },"
+                      << std::endl;
+        }
+
+        newSource << "};" << std::endl
+                  << "}" << std::endl << std::endl;
+
         newSource << "void Parser::addDefaultKeywords() {" << std::endl
-                  << "Opm::ParserKeywords::addDefaultKeywords(*this);" << std::endl
+                  << "for( const auto& factory : default_keywords )" << std::endl
+                  << "    addKeywordFactory( factory );" << std::endl
                   << "}}" << std::endl;
 
         return write_file( newSource, sourceFile, m_verbose, "source" );
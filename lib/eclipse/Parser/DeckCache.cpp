@@ -0,0 +1,501 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Deck/DeckItem.hpp>
+#include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
+#include <opm/parser/eclipse/Deck/DeckRecord.hpp>
+#include <opm/parser/eclipse/Parser/DeckCache.hpp>
+#include <opm/parser/eclipse/Parser/MessageContainer.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Units/Dimension.hpp>
+#include <opm/parser/eclipse/Units/UnitSystem.hpp>
+
+namespace Opm {
+
+namespace {
+
+    const uint64_t cache_magic = 0x4b4345444d504f00; /* "\0OPMDECK" */
+    const uint64_t cache_version = 2;
+
+    const size_t alignment = 8;
+
+    /*
+     * The state of a file as recorded in the cache. Files which could not be
+     * opened when the deck was parsed are recorded as missing.
+     */
+    struct file_stamp {
+        bool exists = false;
+        uint64_t size = 0;
+        uint64_t hash = 0;
+    };
+
+    /* FNV-1a */
+    const uint64_t fnv_offset = 14695981039346656037ULL;
+
+    uint64_t fnv( uint64_t h, const char* data, size_t size ) {
+        for( size_t i = 0; i < size; ++i ) {
+            h ^= static_cast< unsigned char >( data[ i ] );
+            h *= 1099511628211ULL;
+        }
+
+        return h;
+    }
+
+    uint64_t fingerprint( const Parser& parser, const ParseContext& context ) {
+        std::string id = std::to_string( parser.definitionHash() ) + '\n';
+
+        for( const auto& action : context )
+            id += action.first + '=' + std::to_string( int( action.second ) ) + '\n';
+
+        return fnv( fnv_offset, id.data(), id.size() );
+    }
+
+    /*
+     * The size and content hash of a file, both taken from one read through
+     * the same file descriptor so that they describe the same version of the
+     * file. The modification time is not used: it has a resolution of whole
+     * seconds on many file systems, and a file rewritten with the same size
+     * within a second would go unnoticed.
+     */
+    file_stamp stamp( const boost::filesystem::path& path ) {
+        file_stamp st;
+        const int fd = ::open( path.c_str(), O_RDONLY );
+        if( fd < 0 ) return st;
+
+        struct stat sb;
+        if( ::fstat( fd, &sb ) != 0 || !S_ISREG( sb.st_mode ) ) {
+            ::close( fd );
+            return st;
+        }
+
+        uint64_t h = fnv_offset;
+        uint64_t size = 0;
+        std::vector< char > buffer( 1 << 16 );
+        ssize_t count;
+        while( ( count = ::read( fd, buffer.data(), buffer.size() ) ) != 0 ) {
+            if( count < 0 ) {
+                if( errno == EINTR ) continue;
+                ::close( fd );
+                throw std::runtime_error( "Unable to read " + path.string() );
+            }
+
+            h = fnv( h, buffer.data(), count );
+            size += count;
+        }
+
+        ::close( fd );
+        st.exists = true;
+        st.size = size;
+        st.hash = h;
+        return st;
+    }
+
+    bool unchanged( const boost::filesystem::path& path, const file_stamp& cached ) {
+        const auto current = stamp( path );
+
+        if( !cached.exists || !current.exists )
+            return cached.exists == current.exists;
+
+        return current.size == cached.size
+            && current.hash == cached.hash;
+    }
+
+}
+
+    /*
+     * The binary format is written to a buffer in memory, and written to
+     * the cache file in one go.
+     */
+    class DeckCache::Writer {
+    public:
+        template< typename T >
+        void pod( const T& x ) {
+            this->buffer.append( reinterpret_cast< const char* >( &x ), sizeof( T ) );
+        }
+
+        void align() {
+            this->buffer.append( ( alignment - this->buffer.size() % alignment ) % alignment, '\0' );
+        }
+
+        void string( const std::string& str ) {
+            this->pod< uint64_t >( str.size() );
+            this->buffer.append( str );
+            this->align();
+        }
+
+        template< typename T >
+        void array( const std::vector< T >& xs ) {
+            this->pod< uint64_t >( xs.size() );
+            this->buffer.append( reinterpret_cast< const char* >( xs.data() ),
+                                 xs.size() * sizeof( T ) );
+            this->align();
+        }
+
+        void array( const std::vector< bool >& xs ) {
+            this->pod< uint64_t >( xs.size() );
+            for( bool x : xs ) this->buffer.push_back( x ? 1 : 0 );
+            this->align();
+        }
+
+        std::string buffer;
+    };
+
+    /*
+     * Reads from a (mapped) cache file, and throws if the file is truncated.
+     * Since everything is written aligned, arrays are read straight from
+     * the mapped memory.
+     */
+    class DeckCache::Reader {
+    public:
+        Reader( const char* begin, const char* end ) :
+            cursor( begin ), last( end )
+        {}
+
+        template< typename T >
+        T pod() {
+            T x;
+            std::memcpy( &x, this->take( sizeof( T ) ), sizeof( T ) );
+            return x;
+        }
+
+        void align() {
+            const auto offset = reinterpret_cast< uintptr_t >( this->cursor ) % alignment;
+            if( offset != 0 ) this->take( alignment - offset );
+        }
+
+        std::string string() {
+            const auto size = this->pod< uint64_t >();
+            const auto* data = this->take( size );
+            this->align();
+            return std::string( data, size );
+        }
+
+        template< typename T >
+        std::vector< T > array() {
+            const auto size = this->pod< uint64_t >();
+            if( size > uint64_t( this->last - this->cursor ) / sizeof( T ) )
+                throw std::runtime_error( "Deck cache is truncated" );
+
+            const auto* data = reinterpret_cast< const T* >( this->take( size * sizeof( T ) ) );
+            this->align();
+            return std::vector< T >( data, data + size );
+        }
+
+        std::vector< bool > flags() {
+            const auto bytes = this->array< char >();
+            return std::vector< bool >( bytes.begin(), bytes.end() );
+        }
+
+    private:
+        const char* take( size_t size ) {
+            if( size > size_t( this->last - this->cursor ) )
+                throw std::runtime_error( "Deck cache is truncated" );
+
+            const auto* data = this->cursor;
+            this->cursor += size;
+            return data;
+        }
+
+        const char* cursor;
+        const char* last;
+    };
+
+    DeckCache::DeckCache( const std::string& p ) :
+        m_path( p )
+    {}
+
+    const std::string& DeckCache::path() const {
+        return this->m_path;
+    }
+
+    uint64_t DeckCache::hash( const char* data, size_t size ) {
+        return fnv( fnv_offset, data, size );
+    }
+
+    void DeckCache::write( Writer& out, const UnitSystem& units ) {
+        out.pod< int64_t >( static_cast< int64_t >( units.getType() ) );
+        out.pod< uint64_t >( units.m_dimensions.size() );
+        for( const auto& dim : units.m_dimensions ) {
+            out.string( dim.second.getName() );
+            out.pod( dim.second.m_SIfactor );
+            out.pod( dim.second.m_SIoffset );
+        }
+    }
+
+    void DeckCache::read( Reader& in, UnitSystem& units ) {
+        units = UnitSystem( static_cast< UnitSystem::UnitType >( in.pod< int64_t >() ) );
+        units.m_dimensions.clear();
+
+        const auto count = in.pod< uint64_t >();
+        for( uint64_t i = 0; i < count; ++i ) {
+            const auto name = in.string();
+            const auto factor = in.pod< double >();
+            const auto offset = in.pod< double >();
+            units.addDimension( Dimension::newComposite( name, factor, offset ) );
+        }
+    }
+
+    void DeckCache::write( Writer& out, const DeckItem& item ) {
+        out.string( *item.item_name );
+        out.pod< int64_t >( static_cast< int64_t >( item.type ) );
+        out.array( item.ival );
+        out.array( item.dval );
+        out.pod< uint64_t >( item.sval.size() );
+        for( const auto& str : item.sval )
+            out.string( str );
+
+        out.array( item.defaulted );
+        out.pod< uint64_t >( item.dimensions.size() );
+        for( const auto& dim : item.dimensions ) {
+            out.string( dim.getName() );
+            out.pod( dim.m_SIfactor );
+            out.pod( dim.m_SIoffset );
+        }
+    }
+
+    DeckItem DeckCache::readItem( Reader& in ) {
+        DeckItem item( in.string() );
+        item.type = static_cast< type_tag >( in.pod< int64_t >() );
+        item.ival = in.array< int >();
+        item.dval = in.array< double >();
+
+        const auto strings = in.pod< uint64_t >();
+        item.sval.reserve( strings );
+        for( uint64_t i = 0; i < strings; ++i )
+            item.sval.push_back( in.string() );
+
+        item.defaulted = in.flags();
+
+        const auto dimensions = in.pod< uint64_t >();
+        for( uint64_t i = 0; i < dimensions; ++i ) {
+            const auto name = in.string();
+            const auto factor = in.pod< double >();
+            const auto offset = in.pod< double >();
+            item.dimensions.push_back( Dimension::newComposite( name, factor, offset ) );
+        }
+
+        item.convertToSI();
+        return item;
+    }
+
+    void DeckCache::write( Writer& out, const DeckKeyword& keyword ) {
+        out.string( *keyword.m_keywordName );
+        out.string( keyword.getFileName() );
+        out.pod< int64_t >( keyword.m_lineNumber );
+        out.pod< uint8_t >( keyword.m_knownKeyword );
+        out.pod< uint8_t >( keyword.m_isDataKeyword );
+        out.pod< uint8_t >( keyword.m_slashTerminated );
+        out.align();
+
+        out.pod< uint64_t >( keyword.size() );
+        for( const auto& record : keyword ) {
+            out.pod< uint64_t >( record.size() );
+            for( const auto& item : record )
+                write( out, item );
+        }
+    }
+
+    /*
+      The keywords of a file are stored one after the other, so the file
+      name of the previous keyword is shared when it is the same.
+    */
+    DeckKeyword DeckCache::readKeyword( Reader& in, std::shared_ptr< const std::string >& fileName ) {
+        DeckKeyword keyword( in.string() );
+        auto name = in.string();
+        if( !fileName || *fileName != name )
+            fileName = std::make_shared< const std::string >( std::move( name ) );
+
+        keyword.m_fileName = fileName;
+        keyword.m_lineNumber = in.pod< int64_t >();
+        keyword.m_knownKeyword = in.pod< uint8_t >();
+        keyword.m_isDataKeyword = in.pod< uint8_t >();
+        keyword.m_slashTerminated = in.pod< uint8_t >();
+        in.align();
+
+        const auto records = in.pod< uint64_t >();
+        keyword.m_recordList.reserve( records );
+        for( uint64_t r = 0; r < records; ++r ) {
+            const auto size = in.pod< uint64_t >();
+            std::vector< DeckItem > items;
+            items.reserve( size );
+            for( uint64_t i = 0; i < size; ++i )
+                items.push_back( readItem( in ) );
+
+            keyword.m_recordList.emplace_back( std::move( items ) );
+        }
+
+        return keyword;
+    }
+
+    void DeckCache::store( const Deck& deck,
+                           const std::vector< boost::filesystem::path >& files,
+                           const Parser& parser,
+                           const ParseContext& context ) const {
+        try {
+            Writer out;
+            out.pod( cache_magic );
+            out.pod( cache_version );
+            out.pod( fingerprint( parser, context ) );
+
+            out.pod< uint64_t >( files.size() );
+            for( const auto& file : files ) {
+                const auto st = stamp( file );
+                out.string( file.string() );
+                out.pod< uint64_t >( st.exists );
+                out.pod( st.size );
+                out.pod( st.hash );
+            }
+
+            out.string( deck.getDataFile() );
+            write( out, deck.getDefaultUnitSystem() );
+            write( out, deck.getActiveUnitSystem() );
+
+            const auto& messages = deck.getMessageContainer();
+            out.pod< uint64_t >( messages.size() );
+            for( const auto& msg : messages ) {
+                out.pod< int64_t >( msg.mtype );
+                out.string( msg.message );
+                out.string( msg.location.filename );
+                out.pod< uint64_t >( msg.location.lineno );
+            }
+
+            out.pod< uint64_t >( deck.size() );
+            for( const auto& keyword : deck )
+                write( out, keyword );
+
+            /*
+             * Write to a temporary file which is renamed in place, so that
+             * concurrent runs never see a partially written cache.
+             */
+            const auto tmp = this->m_path + "." + boost::filesystem::unique_path().string();
+            {
+                std::ofstream stream( tmp, std::ios::binary | std::ios::trunc );
+                stream.write( out.buffer.data(), out.buffer.size() );
+                if( !stream ) {
+                    boost::filesystem::remove( tmp );
+                    return;
+                }
+            }
+
+            boost::filesystem::rename( tmp, this->m_path );
+        } catch( const std::exception& ) {
+            /* the cache is an optimisation, failing to write it is not an error */
+        }
+    }
+
+    bool DeckCache::load( const std::string& dataFile,
+                          const Parser& parser,
+                          const ParseContext& context,
+                          Deck& deck ) const {
+        const int fd = ::open( this->m_path.c_str(), O_RDONLY );
+        if( fd < 0 ) return false;
+
+        struct stat st;
+        if( ::fstat( fd, &st ) != 0 || st.st_size == 0 ) {
+            ::close( fd );
+            return false;
+        }
+
+        const auto size = static_cast< size_t >( st.st_size );
+        void* addr = mmap( nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        ::close( fd );
+        if( addr == MAP_FAILED ) return false;
+
+        std::unique_ptr< void, std::function< void( void* ) > > mapping(
+            addr, [size]( void* p ) { munmap( p, size ); } );
+
+        try {
+            const auto* begin = static_cast< const char* >( addr );
+            Reader in( begin, begin + size );
+
+            if( in.pod< uint64_t >() != cache_magic ) return false;
+            if( in.pod< uint64_t >() != cache_version ) return false;
+            if( in.pod< uint64_t >() != fingerprint( parser, context ) ) return false;
+
+            const auto files = in.pod< uint64_t >();
+            for( uint64_t i = 0; i < files; ++i ) {
+                const boost::filesystem::path file( in.string() );
+                file_stamp cached;
+                cached.exists = in.pod< uint64_t >();
+                cached.size = in.pod< uint64_t >();
+                cached.hash = in.pod< uint64_t >();
+
+                if( i == 0 && file != boost::filesystem::canonical( dataFile ) )
+                    return false;
+
+                if( !unchanged( file, cached ) ) return false;
+            }
+
+            const auto data_file = in.string();
+
+            UnitSystem default_units;
+            UnitSystem active_units;
+            read( in, default_units );
+            read( in, active_units );
+
+            std::vector< Message > messages;
+            const auto message_count = in.pod< uint64_t >();
+            for( uint64_t i = 0; i < message_count; ++i ) {
+                const auto mtype = static_cast< Message::type >( in.pod< int64_t >() );
+                const auto message = in.string();
+                const auto filename = in.string();
+                const auto lineno = in.pod< uint64_t >();
+                if( lineno == 0 )
+                    messages.emplace_back( mtype, message );
+                else
+                    messages.emplace_back( mtype, message, Location( filename, lineno ) );
+            }
+
+            std::vector< DeckKeyword > keywords;
+            std::shared_ptr< const std::string > fileName;
+            const auto keyword_count = in.pod< uint64_t >();
+            keywords.reserve( keyword_count );
+            for( uint64_t i = 0; i < keyword_count; ++i )
+                keywords.push_back( readKeyword( in, fileName ) );
+
+            deck.setDataFile( data_file );
+            deck.getDefaultUnitSystem() = default_units;
+            deck.getActiveUnitSystem() = active_units;
+            for( auto& msg : messages )
+                deck.getMessageContainer().add( std::move( msg ) );
+
+            for( auto& keyword : keywords )
+                deck.addKeyword( std::move( keyword ) );
+
+            return true;
+        } catch( const std::exception& ) {
+            return false;
+        }
+    }
+
+}
@@ -0,0 +1,168 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <opm/parser/eclipse/Parser/DeckNameHash.hpp>
+
+namespace Opm {
+
+namespace {
+
+    /* the finalizer of MurmurHash3 */
+    inline uint64_t mix( uint64_t x ) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    inline size_t bucket_of( uint64_t key, size_t buckets ) {
+        return mix( key ) % buckets;
+    }
+
+    inline size_t slot_of( uint64_t key, uint32_t seed, size_t slots ) {
+        return mix( key ^ ( 0x9e3779b97f4a7c15ULL * ( uint64_t( seed ) + 1 ) ) ) % slots;
+    }
+
+    /*
+     * Try to place all buckets in a table with the given number of slots,
+     * the largest buckets first. Returns false if some bucket can not be
+     * placed with any seed.
+     */
+    bool place( const std::vector< uint64_t >& keys,
+                size_t buckets,
+                size_t slots,
+                DeckNameHash::table& t ) {
+        const uint32_t max_seed = 1 << 16;
+
+        std::vector< std::vector< uint64_t > > members( buckets );
+        for( const auto key : keys )
+            members[ bucket_of( key, buckets ) ].push_back( key );
+
+        std::vector< size_t > order( buckets );
+        for( size_t i = 0; i < buckets; ++i ) order[ i ] = i;
+        std::stable_sort( order.begin(), order.end(), [&]( size_t lhs, size_t rhs ) {
+            return members[ lhs ].size() > members[ rhs ].size();
+        } );
+
+        t.seeds.assign( buckets, 0 );
+        t.keys.assign( slots, 0 );
+
+        std::vector< size_t > candidate;
+        for( const auto b : order ) {
+            if( members[ b ].empty() ) break;
+
+            uint32_t seed = 0;
+            for( ; seed < max_seed; ++seed ) {
+                candidate.clear();
+                for( const auto key : members[ b ] ) {
+                    const auto s = slot_of( key, seed, slots );
+                    if( t.keys[ s ] != 0 ) break;
+                    if( std::find( candidate.begin(), candidate.end(), s ) != candidate.end() ) break;
+                    candidate.push_back( s );
+                }
+
+                if( candidate.size() == members[ b ].size() ) break;
+            }
+
+            if( seed == max_seed ) return false;
+
+            t.seeds[ b ] = seed;
+            for( size_t i = 0; i < candidate.size(); ++i )
+                t.keys[ candidate[ i ] ] = members[ b ][ i ];
+        }
+
+        return true;
+    }
+
+}
+
+    DeckNameHash::DeckNameHash( const uint32_t* s, size_t b,
+                                const uint64_t* k, size_t n ) :
+        seeds( s ), buckets( b ), keys( k ), slots( n )
+    {
+        if( this->buckets == 0 || this->slots == 0 )
+            throw std::invalid_argument( "A deck name hash needs at least one bucket and one slot" );
+    }
+
+    DeckNameHash::DeckNameHash( const table& t ) :
+        DeckNameHash( t.seeds.data(), t.seeds.size(), t.keys.data(), t.keys.size() )
+    {}
+
+    int DeckNameHash::slot( const string_view& name ) const {
+        const auto key = pack( name );
+        if( key == 0 ) return -1;
+
+        const auto seed = this->seeds[ bucket_of( key, this->buckets ) ];
+        const auto s = slot_of( key, seed, this->slots );
+
+        return this->keys[ s ] == key ? int( s ) : -1;
+    }
+
+    std::string DeckNameHash::name( size_t s ) const {
+        return unpack( this->keys[ s ] );
+    }
+
+    size_t DeckNameHash::size() const {
+        return this->slots;
+    }
+
+    uint64_t DeckNameHash::pack( const string_view& name ) {
+        if( name.empty() || name.size() > 8 ) return 0;
+
+        uint64_t key = 0;
+        for( size_t i = 0; i < name.size(); ++i )
+            key |= uint64_t( static_cast< unsigned char >( name[ i ] ) ) << ( 8 * i );
+
+        return key;
+    }
+
+    std::string DeckNameHash::unpack( uint64_t key ) {
+        std::string name;
+        for( ; key != 0; key >>= 8 )
+            name.push_back( char( key & 0xff ) );
+
+        return name;
+    }
+
+    DeckNameHash::table DeckNameHash::build( const std::vector< std::string >& names ) {
+        std::vector< uint64_t > keys;
+        for( const auto& name : names ) {
+            const auto key = pack( name );
+            if( key != 0 ) keys.push_back( key );
+        }
+
+        std::sort( keys.begin(), keys.end() );
+        keys.erase( std::unique( keys.begin(), keys.end() ), keys.end() );
+
+        /* around four names per bucket and a load factor of 0.8 */
+        const size_t buckets = std::max< size_t >( 1, keys.size() / 4 );
+        table t;
+        for( size_t slots = std::max< size_t >( 1, keys.size() + keys.size() / 4 );
+             !place( keys, buckets, slots, t );
+             slots += slots / 16 + 1 )
+        {}
+
+        return t;
+    }
+}
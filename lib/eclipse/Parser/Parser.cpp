@@ -17,9 +17,20 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <fstream>
+#include <future>
 #include <memory>
+#include <sstream>
+#include <stack>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
@@ -33,6 +44,8 @@
 #include <opm/parser/eclipse/Deck/Section.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/Parser/DeckCache.hpp>
+#include <opm/parser/eclipse/Parser/KeywordVisitor.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/ParserItem.hpp>
@@ -136,71 +149,391 @@ inline string_view strip_slash( string_view view ) {
     return { begin, slash };
 }
 
+/*
+ * Clean a single line of input in place, removing everything that isn't
+ * interesting data: comments and everything after a (terminating) slash. The
+ * removed characters are overwritten with blanks rather than compacted away,
+ * so the line stays where it is in the input buffer. A record spanning
+ * several lines is then still one contiguous range of separator-delimited
+ * tokens, and lines with nothing to remove - the bulk of large numeric
+ * keywords - are never written to.
+ *
+ * Returns the cleaned line with leading and trailing whitespace trimmed.
+ */
+inline string_view clean_line( char* begin, char* end ) {
+    const auto data = strip_slash( strip_comments( { begin, end } ) );
+    const auto is_separator = RawConsts::is_separator();
+
+    for( auto* itr = begin + ( data.end() - begin ); itr != end; ++itr )
+        if( !is_separator( *itr ) ) *itr = ' ';
+
+    return trim( data );
+}
+
+/*
+ * Get the next line of the input, clean it and advance input past it. The
+ * buffer viewed by input must be writable, see clean_line. The last line of
+ * the input does not have to be terminated by a newline.
+ */
 inline bool getline( string_view& input, string_view& line ) {
     if( input.empty() ) return false;
 
-    auto end = std::find( input.begin(), input.end(), '\n' );
+    auto* begin = const_cast< char* >( input.begin() );
+    auto* end = std::find( begin, const_cast< char* >( input.end() ), '\n' );
 
-    line = string_view( input.begin(), end );
-    input = string_view( end + 1, input.end() );
+    line = clean_line( begin, end );
+    input = string_view( end == input.end() ? end : end + 1, input.end() );
     return true;
-
-    /* we know that we always append a newline onto the input string, so we can
-     * safely assume that end+1 will either be end-of-input (i.e. empty range)
-     * or the start of the next line
-     */
 }
 
+const std::string emptystr = "";
+
 /*
- * Read the input file and remove everything that isn't interesting data,
- * including stripping comments, removing leading/trailing whitespaces and
- * everything after (terminating) slashes. Manually copying into the string for
- * performance.
+ * The storage for the input of a file on the stack. Strings are copied into
+ * memory, whereas files are mapped private and writable; cleaning a line in
+ * place then only copies the page it is on, and is never visible in the file
+ * itself.
  */
-inline std::string clean( const std::string& str ) {
-    std::string dst;
-    dst.resize( str.size() );
+std::shared_ptr< char > copy_input( const std::string& input ) {
+    auto storage = std::make_shared< std::string >( input );
+    return std::shared_ptr< char >( storage, &( *storage )[ 0 ] );
+}
 
-    string_view input( str ), line;
-    auto dsti = dst.begin();
-    while( getline( input, line ) ) {
-        line = trim( strip_slash( strip_comments( line ) ) );
+std::shared_ptr< char > map_input( int fd, size_t size ) {
+    void* addr = mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+    if( addr == MAP_FAILED ) return {};
 
-        std::copy( line.begin(), line.end(), dsti );
-        dsti += std::distance( line.begin(), line.end() );
-        *dsti++ = '\n';
-    }
+    madvise( addr, size, MADV_SEQUENTIAL );
 
-    dst.resize( std::distance( dst.begin(), dsti ) );
-    return dst;
+    return std::shared_ptr< char >( static_cast< char* >( addr ),
+                                    [size]( char* p ) { munmap( p, size ); } );
 }
 
-const std::string emptystr = "";
-
 struct file {
-    file( boost::filesystem::path p, const std::string& in ) :
-        input( in ), path( p )
+    file( boost::filesystem::path p, std::shared_ptr< char > buffer, size_t size, bool is_mapped ) :
+        input( buffer.get(), size ),
+        path( p ),
+        name( std::make_shared< const std::string >( p.string() ) ),
+        storage( std::move( buffer ) ),
+        mapped( is_mapped )
     {}
 
+    void discard_consumed( const string_view& keep );
+
     string_view input;
     size_t lineNR = 0;
     boost::filesystem::path path;
+    /* the file name of the raw and deck keywords read from the file */
+    std::shared_ptr< const std::string > name;
+    std::shared_ptr< char > storage;
+    bool mapped;
+    size_t discarded = 0;
 };
 
+/*
+ * Give the pages of a mapped file which have already been parsed back to the
+ * system. Every page with a line that was cleaned is a private copy, so
+ * without this a parse would eventually hold on to memory in the order of
+ * the size of its input. This is done in large steps to keep the number of
+ * system calls down.
+ *
+ * The mapping is private, so a discarded page reads as the file again, and
+ * the lines which were cleaned in place on it are lost. Nothing may view into
+ * the input before keep, or before the current position if keep is not in
+ * the consumed part of this file.
+ */
+void file::discard_consumed( const string_view& keep ) {
+    static const size_t page = sysconf( _SC_PAGESIZE );
+    const size_t step = size_t( 1 ) << 24;
+
+    if( !this->mapped ) return;
+
+    const char* end = this->input.begin();
+    if( keep.begin() >= this->storage.get() && keep.begin() < end )
+        end = keep.begin();
+
+    const auto consumed = size_t( end - this->storage.get() ) / page * page;
+    if( consumed - this->discarded < step ) return;
+
+    madvise( this->storage.get() + this->discarded, consumed - this->discarded, MADV_DONTNEED );
+    this->discarded = consumed;
+}
+
+/*
+ * A file is popped off the stack as soon as its input is exhausted, but the
+ * keyword which was being read at that point can still view into it. The
+ * storage of popped files is therefore kept until release() is called, which
+ * is when no raw keyword can refer to it any more.
+ */
 class InputStack : public std::stack< file, std::vector< file > > {
     public:
-        void push( std::string&& input, boost::filesystem::path p = "" );
+        void push( std::shared_ptr< char > input, size_t size,
+                   boost::filesystem::path p = "", bool mapped = false );
+        void pop();
+        void release();
+        void discard_consumed( const string_view& keep );
 
     private:
-        std::list< std::string > string_storage;
+        std::vector< std::shared_ptr< char > > closed_storage;
         using base = std::stack< file, std::vector< file > >;
 };
 
-void InputStack::push( std::string&& input, boost::filesystem::path p ) {
-    this->string_storage.push_back( std::move( input ) );
-    this->emplace( p, this->string_storage.back() );
+void InputStack::push( std::shared_ptr< char > input, size_t size,
+                       boost::filesystem::path p, bool mapped ) {
+    this->emplace( p, std::move( input ), size, mapped );
+}
+
+void InputStack::pop() {
+    this->closed_storage.push_back( std::move( this->top().storage ) );
+    this->base::pop();
+}
+
+void InputStack::release() {
+    this->closed_storage.clear();
+}
+
+void InputStack::discard_consumed( const string_view& keep ) {
+    if( !this->empty() ) this->top().discard_consumed( keep );
+}
+
+/*
+ * Resolve the path of an INCLUDE file, substituting $ALIAS with the aliases
+ * defined by PATHS and backslashes with slashes. Relative paths are relative
+ * to the root (DATA file) directory.
+ */
+boost::filesystem::path include_path( std::string path,
+                                      const std::map< std::string, std::string >& aliases,
+                                      const boost::filesystem::path& root,
+                                      bool& backslash ) {
+    static const std::string pathKeywordPrefix("$");
+    static const std::string validPathNameCharacters("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_");
+
+    size_t positionOfPathName = path.find(pathKeywordPrefix);
+
+    if ( positionOfPathName != std::string::npos) {
+        std::string stringStartingAtPathName = path.substr(positionOfPathName+1);
+        size_t cutOffPosition = stringStartingAtPathName.find_first_not_of(validPathNameCharacters);
+        std::string stringToFind = stringStartingAtPathName.substr(0, cutOffPosition);
+        std::string stringToReplace = aliases.at( stringToFind );
+        boost::replace_all(path, pathKeywordPrefix + stringToFind, stringToReplace);
+    }
+
+    backslash = path.find('\\') != std::string::npos;
+    std::replace(path.begin(), path.end(), '\\', '/');
+
+    boost::filesystem::path includeFilePath(path);
+
+    if (includeFilePath.is_relative())
+        return root / includeFilePath;
+
+    return includeFilePath;
+}
+
+/*
+ * Thrown by a speculative parser state when the file it parses can not be
+ * parsed correctly on its own, see IncludeParser.
+ */
+struct speculation_failed {};
+
+bool is_section_name( const std::string& name ) {
+    for( const auto& x : { "RUNSPEC", "GRID", "EDIT", "PROPS",
+                           "REGIONS", "SOLUTION", "SUMMARY", "SCHEDULE" } )
+        if( name == x ) return true;
+
+    return false;
+}
+
+/*
+ * If multiple unit systems are requested, metric is preferred over lab, and
+ * field over metric, for as long as we have no easy way of figuring out which
+ * was requested last.
+ */
+void select_unit_system( Deck& deck ) {
+    if( deck.hasKeyword( "LAB" ) )
+        deck.getActiveUnitSystem() = UnitSystem::newLAB();
+    if( deck.hasKeyword( "FIELD" ) )
+        deck.getActiveUnitSystem() = UnitSystem::newFIELD();
+    if( deck.hasKeyword( "METRIC" ) )
+        deck.getActiveUnitSystem() = UnitSystem::newMETRIC();
+}
+
+void apply_units( const Parser& parser, Deck& deck, DeckKeyword& deckKeyword ) {
+    if( !parser.isRecognizedKeyword( deckKeyword.name() ) ) return;
+
+    const auto* parserKeyword = parser.getParserKeywordFromDeckName( deckKeyword.name() );
+    if( !parserKeyword->hasDimension() ) return;
+
+    parserKeyword->applyUnitsToDeck( deck, deckKeyword );
+}
+
+/*
+ * Hand the parsed keywords to a visitor instead of adding them to the deck.
+ * Only the RUNSPEC section is kept in the deck, which is what the rest of the
+ * deck needs to be parsed: it holds the keywords which define the size of
+ * other keywords, and the unit system. The RUNSPEC keywords are visited when
+ * the section ends, once the unit system is known. Keywords before the first
+ * section keyword are considered part of RUNSPEC.
+ */
+class KeywordStream {
+    public:
+        KeywordStream( const Parser&, KeywordVisitor& );
+
+        bool accept( const std::string& name, Deck& );
+        void add( DeckKeyword&&, Deck& );
+        void finish( Deck& );
+
+    private:
+        const Parser& parser;
+        KeywordVisitor& visitor;
+
+        bool runspec = true;
+        bool skip_section = false;
+        bool wanted = false;
+        std::vector< bool > visit_runspec;
+};
+
+KeywordStream::KeywordStream( const Parser& p, KeywordVisitor& v ) :
+    parser( p ),
+    visitor( v )
+{}
+
+/*
+ * Whether the keyword should be parsed at all.
+ */
+bool KeywordStream::accept( const std::string& name, Deck& deck ) {
+    if( is_section_name( name ) ) {
+        if( this->runspec && name != "RUNSPEC" )
+            this->finish( deck );
+
+        this->skip_section = !this->visitor.section( name );
+    }
+
+    this->wanted = !this->skip_section && this->visitor.keyword( name );
+    return this->wanted || this->runspec;
+}
+
+void KeywordStream::add( DeckKeyword&& keyword, Deck& deck ) {
+    if( this->runspec ) {
+        deck.addKeyword( std::move( keyword ) );
+        this->visit_runspec.push_back( this->wanted );
+        return;
+    }
+
+    apply_units( this->parser, deck, keyword );
+    this->visitor.visit( std::move( keyword ) );
+}
+
+void KeywordStream::finish( Deck& deck ) {
+    if( !this->runspec ) return;
+    this->runspec = false;
+
+    select_unit_system( deck );
+    for( size_t i = 0; i < this->visit_runspec.size(); ++i ) {
+        if( !this->visit_runspec[ i ] ) continue;
+
+        auto keyword = deck.getKeyword( i );
+        apply_units( this->parser, deck, keyword );
+        this->visitor.visit( std::move( keyword ) );
+    }
+}
+
+/*
+ * The literal prefixes of the alternatives of a regular expression, e.g. FU
+ * and FTPR for FU.+|FTPR.+, one of which every name it matches starts with.
+ * An alternative which starts with something other than a literal or a group
+ * gives the empty prefix, so this never misses a possible match.
+ */
+std::vector< std::string > regex_prefixes( std::string::const_iterator begin,
+                                           std::string::const_iterator end ) {
+    using itr_type = std::string::const_iterator;
+
+    const auto literal = []( char c ) {
+        return std::isalnum( c ) || c == '_' || c == '-';
+    };
+
+    const auto optional = [end]( itr_type itr ) {
+        return itr != end && ( *itr == '?' || *itr == '*' || *itr == '{' );
+    };
+
+    /*
+     * The end of the alternative starting at itr, or one past the closing
+     * parenthesis of the group whose content starts at itr.
+     */
+    const auto skip = [end]( itr_type itr, bool alternative ) {
+        int depth = 0;
+        bool bracket = false;
+        for( ; itr != end; ++itr ) {
+            if( *itr == '\\' ) {
+                if( ++itr == end ) break;
+                continue;
+            }
+
+            if( bracket ) {
+                bracket = *itr != ']';
+                continue;
+            }
+
+            if( *itr == '[' ) bracket = true;
+            else if( *itr == '(' ) ++depth;
+            else if( *itr == ')' ) {
+                if( depth == 0 ) return alternative ? itr : itr + 1;
+                --depth;
+            }
+            else if( *itr == '|' && depth == 0 && alternative ) return itr;
+        }
+
+        return itr;
+    };
+
+    const auto common_prefix = []( const std::vector< std::string >& strings ) {
+        auto common = strings.front();
+        for( const auto& str : strings ) {
+            size_t n = 0;
+            while( n < common.size() && n < str.size() && common[ n ] == str[ n ] ) ++n;
+            common.resize( n );
+        }
+
+        return common;
+    };
+
+    std::vector< std::string > prefixes;
+    auto itr = begin;
+    while( true ) {
+        const auto alt_end = skip( itr, true );
+        std::string prefix;
+
+        while( itr != alt_end ) {
+            if( literal( *itr ) ) {
+                if( optional( itr + 1 ) ) break;
+                prefix.push_back( *itr++ );
+                if( itr != alt_end && *itr == '+' ) break;
+                continue;
+            }
+
+            if( *itr == '(' ) {
+                const auto group_end = skip( itr + 1, false );
+                const bool closed = group_end != itr + 1 && *( group_end - 1 ) == ')';
+                if( closed && !optional( group_end ) )
+                    prefix += common_prefix( regex_prefixes( itr + 1, group_end - 1 ) );
+            }
+
+            break;
+        }
+
+        prefixes.push_back( prefix );
+        if( alt_end == end ) break;
+        itr = alt_end + 1;
+    }
+
+    return prefixes;
 }
 
+std::vector< std::string > regex_prefixes( const std::string& regex ) {
+    return regex_prefixes( regex.begin(), regex.end() );
+}
+
+class IncludeParser;
+
 class ParserState {
     public:
         ParserState( const ParseContext& );
@@ -208,21 +541,34 @@ class ParserState {
 
         void loadString( const std::string& );
         void loadFile( const boost::filesystem::path& );
+        void loadInclude( const boost::filesystem::path&,
+                          const boost::filesystem::path& root,
+                          const std::map< std::string, std::string >& aliases );
         void openRootFile( const boost::filesystem::path& );
+        void prefetchIncludes( IncludeParser& );
 
         void handleRandomText(const string_view& ) const;
         boost::filesystem::path getIncludeFilePath( std::string ) const;
         void addPathAlias( const std::string& alias, const std::string& path );
+        const std::map< std::string, std::string >& pathAliases() const;
 
         const boost::filesystem::path& current_path() const;
+        const std::shared_ptr< const std::string >& current_name() const;
         size_t line() const;
 
         bool done() const;
         string_view getline();
         void closeFile();
+        void releaseClosedFiles();
+        void discardConsumedInput();
+        const std::vector< boost::filesystem::path >& files() const;
+        void addFiles( const std::vector< boost::filesystem::path >& );
+        void addKeyword( DeckKeyword&& );
 
     private:
         InputStack input_stack;
+        /* every file the parser has tried to load, in order */
+        std::vector< boost::filesystem::path > loaded_files;
 
         std::map< std::string, std::string > pathMap;
         boost::filesystem::path rootPath;
@@ -236,6 +582,63 @@ class ParserState {
         Deck deck;
         const ParseContext& parseContext;
         bool unknown_keyword = false;
+
+        /*
+         * A speculative state gives up by throwing speculation_failed rather
+         * than parse something that depends on input outside its own file.
+         */
+        bool speculative = false;
+        IncludeParser* includes = nullptr;
+        KeywordStream* stream = nullptr;
+};
+
+/*
+ * Parse INCLUDE files speculatively on a pool of threads. The INCLUDE
+ * keywords of the root file are found by a cheap textual scan before parsing
+ * starts, and the included files are then parsed by the workers, each into
+ * a deck of its own. When the parser reaches an INCLUDE it takes the
+ * keywords and messages of the matching file and appends them to its deck,
+ * which gives exactly the deck that parsing the include serially would.
+ *
+ * An include file can not always be parsed on its own - it can depend on
+ * keywords defined before it (e.g. the size of a table), the last keyword in
+ * it can continue into the including file, or it can define PATHS for the
+ * files included later. The worker gives up when it detects something like
+ * this, and that file is then parsed serially as usual.
+ */
+class IncludeParser {
+    public:
+        IncludeParser( const Parser&, const ParseContext&,
+                       const boost::filesystem::path& root, size_t threads );
+        ~IncludeParser();
+
+        void add( const boost::filesystem::path&,
+                  const std::map< std::string, std::string >& aliases );
+        void start();
+        bool splice( const boost::filesystem::path&, ParserState& );
+
+    private:
+        struct job {
+            boost::filesystem::path path;
+            std::map< std::string, std::string > aliases;
+            std::unique_ptr< ParserState > state;
+            std::promise< void > done;
+            std::future< void > ready;
+        };
+
+        void work();
+        void parse( job& ) const;
+
+        const Parser& parser;
+        const ParseContext& context;
+        boost::filesystem::path root;
+        size_t num_threads;
+
+        std::vector< std::unique_ptr< job > > jobs;
+        size_t current = 0;
+        std::atomic< size_t > next;
+        std::atomic< bool > cancelled;
+        std::vector< std::thread > workers;
 };
 
 
@@ -243,6 +646,10 @@ const boost::filesystem::path& ParserState::current_path() const {
     return this->input_stack.top().path;
 }
 
+const std::shared_ptr< const std::string >& ParserState::current_name() const {
+    return this->input_stack.top().name;
+}
+
 size_t ParserState::line() const {
     return this->input_stack.top().lineNR;
 }
@@ -269,6 +676,29 @@ void ParserState::closeFile() {
     this->input_stack.pop();
 }
 
+void ParserState::releaseClosedFiles() {
+    this->input_stack.release();
+}
+
+void ParserState::discardConsumedInput() {
+    this->input_stack.discard_consumed( this->nextKeyword );
+}
+
+const std::vector< boost::filesystem::path >& ParserState::files() const {
+    return this->loaded_files;
+}
+
+void ParserState::addFiles( const std::vector< boost::filesystem::path >& paths ) {
+    this->loaded_files.insert( this->loaded_files.end(), paths.begin(), paths.end() );
+}
+
+void ParserState::addKeyword( DeckKeyword&& keyword ) {
+    if( this->stream )
+        this->stream->add( std::move( keyword ), this->deck );
+    else
+        this->deck.addKeyword( std::move( keyword ) );
+}
+
 ParserState::ParserState(const ParseContext& __parseContext) :
     parseContext( __parseContext )
 {}
@@ -282,7 +712,7 @@ ParserState::ParserState( const ParseContext& context,
 }
 
 void ParserState::loadString(const std::string& input) {
-    this->input_stack.push( clean( input + "\n" ) );
+    this->input_stack.push( copy_input( input ), input.size() );
 }
 
 void ParserState::loadFile(const boost::filesystem::path& inputFile) {
@@ -290,43 +720,100 @@ void ParserState::loadFile(const boost::filesystem::path& inputFile) {
     boost::filesystem::path inputFileCanonical;
     try {
         inputFileCanonical = boost::filesystem::canonical(inputFile);
+        this->loaded_files.push_back( inputFileCanonical );
     } catch (boost::filesystem::filesystem_error fs_error) {
+        this->loaded_files.push_back( inputFile );
         std::string msg = "Could not open file: " + inputFile.string();
         parseContext.handleError( ParseContext::PARSE_MISSING_INCLUDE , deck.getMessageContainer() , msg);
         return;
     }
 
-    const auto closer = []( std::FILE* f ) { std::fclose( f ); };
-    std::unique_ptr< std::FILE, decltype( closer ) > ufp(
-            std::fopen( inputFileCanonical.string().c_str(), "rb" ),
-            closer
-            );
-
     // make sure the file we'd like to parse is readable
-    if( !ufp ) {
+    const int fd = ::open( inputFileCanonical.string().c_str(), O_RDONLY );
+    struct stat st;
+    if( fd < 0 || ::fstat( fd, &st ) != 0 ) {
+        if( fd >= 0 ) ::close( fd );
         std::string msg = "Could not read from file: " + inputFile.string();
         parseContext.handleError( ParseContext::PARSE_MISSING_INCLUDE , deck.getMessageContainer() , msg);
         return;
     }
 
     /*
-     * read the input file C-style. This is done for performance
-     * reasons, as streams are slow
+     * map the input file rather than reading it. This is done for memory
+     * reasons; the input is viewed directly in the page cache and cleaned
+     * lazily as it is read, and the mapping is released when the file has
+     * been parsed.
      */
+    const auto size = static_cast< size_t >( st.st_size );
+    auto buffer = size > 0 ? map_input( fd, size ) : copy_input( emptystr );
+    ::close( fd );
 
-    auto* fp = ufp.get();
-    std::string buffer;
-    std::fseek( fp, 0, SEEK_END );
-    buffer.resize( std::ftell( fp ) + 1 );
-    std::rewind( fp );
-    const auto readc = std::fread( &buffer[ 0 ], 1, buffer.size() - 1, fp );
-    buffer.back() = '\n';
-
-    if( std::ferror( fp ) || readc != buffer.size() - 1 )
+    if( !buffer )
         throw std::runtime_error( "Error when reading input file '"
                                 + inputFileCanonical.string() + "'" );
 
-    this->input_stack.push( clean( buffer ), inputFileCanonical );
+    this->input_stack.push( std::move( buffer ), size, inputFileCanonical, size > 0 );
+}
+
+void ParserState::loadInclude( const boost::filesystem::path& inputFile,
+                               const boost::filesystem::path& root,
+                               const std::map< std::string, std::string >& aliases ) {
+    this->rootPath = root;
+    this->pathMap = aliases;
+    this->loadFile( inputFile );
+}
+
+/*
+ * Scan the root file for INCLUDE and PATHS and hand the include files to the
+ * include parser. This is a textual scan of the lines following the INCLUDE
+ * and PATHS keyword names which does not parse the deck, and it is allowed to
+ * be wrong - a file the parser does not later include is never spliced in.
+ */
+void ParserState::prefetchIncludes( IncludeParser& includes ) {
+    if( this->input_stack.empty() ) return;
+
+    auto aliases = this->pathMap;
+    auto input = this->input_stack.top().input;
+    string_view line;
+    string_view record = emptystr;
+    std::string keyword;
+    std::string current;
+
+    try {
+        while( Opm::getline( input, line ) ) {
+            if( line.empty() ) continue;
+
+            if( current.empty() ) {
+                if( RawKeyword::isKeywordPrefix( line, keyword )
+                    && ( keyword == RawConsts::include || keyword == RawConsts::paths ) )
+                    current = keyword;
+
+                continue;
+            }
+
+            record = record.empty() ? line : string_view( record.begin(), line.end() );
+            if( !RawRecord::isTerminatedRecordString( record ) ) continue;
+
+            const RawRecord rec( string_view( record.begin(), record.end() - 1 ) );
+            record = emptystr;
+
+            if( current == RawConsts::paths && rec.size() >= 2 ) {
+                aliases.emplace( readValueToken< std::string >( rec.getItem( 0 ) ),
+                                 readValueToken< std::string >( rec.getItem( 1 ) ) );
+                continue;
+            }
+
+            if( current == RawConsts::include && rec.size() > 0 ) {
+                bool backslash;
+                try {
+                    const auto name = readValueToken< std::string >( rec.getItem( 0 ) );
+                    includes.add( include_path( name, aliases, this->rootPath, backslash ), aliases );
+                } catch( const std::out_of_range& ) {}
+            }
+
+            current.clear();
+        }
+    } catch( const std::exception& ) {}
 }
 
 /*
@@ -336,6 +823,10 @@ void ParserState::loadFile(const boost::filesystem::path& inputFile) {
  */
 
 void ParserState::handleRandomText(const string_view& keywordString ) const {
+    /* how to report this depends on the keyword before the include */
+    if( this->speculative && this->lastKeyWord.empty() )
+        throw speculation_failed();
+
     std::string errorKey;
     std::stringstream msg;
     std::string trimmedCopy = keywordString.string();
@@ -376,30 +867,11 @@ void ParserState::openRootFile( const boost::filesystem::path& inputFile) {
 }
 
 boost::filesystem::path ParserState::getIncludeFilePath( std::string path ) const {
-    static const std::string pathKeywordPrefix("$");
-    static const std::string validPathNameCharacters("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_");
+    bool backslash;
+    auto includeFilePath = include_path( path, this->pathMap, this->rootPath, backslash );
 
-    size_t positionOfPathName = path.find(pathKeywordPrefix);
-
-    if ( positionOfPathName != std::string::npos) {
-        std::string stringStartingAtPathName = path.substr(positionOfPathName+1);
-        size_t cutOffPosition = stringStartingAtPathName.find_first_not_of(validPathNameCharacters);
-        std::string stringToFind = stringStartingAtPathName.substr(0, cutOffPosition);
-        std::string stringToReplace = this->pathMap.at( stringToFind );
-        boost::replace_all(path, pathKeywordPrefix + stringToFind, stringToReplace);
-    }
-
-    // Check if there are any backslashes in the path...
-    if (path.find('\\') != std::string::npos) {
-        // ... if so, replace with slashes and create a warning.
-        std::replace(path.begin(), path.end(), '\\', '/');
+    if( backslash )
         deck.getMessageContainer().warning("Replaced one or more backslash with a slash in an INCLUDE path.");
-    }
-
-    boost::filesystem::path includeFilePath(path);
-
-    if (includeFilePath.is_relative())
-        return this->rootPath / includeFilePath;
 
     return includeFilePath;
 }
@@ -408,6 +880,10 @@ void ParserState::addPathAlias( const std::string& alias, const std::string& pat
     this->pathMap.emplace( alias, path );
 }
 
+const std::map< std::string, std::string >& ParserState::pathAliases() const {
+    return this->pathMap;
+}
+
 std::shared_ptr< RawKeyword > createRawKeyword( const string_view& kw, ParserState& parserState, const Parser& parser ) {
     auto keywordString = ParserKeyword::getDeckName( kw );
 
@@ -437,13 +913,13 @@ std::shared_ptr< RawKeyword > createRawKeyword( const string_view& kw, ParserSta
                                 : Raw::UNKNOWN;
 
         return std::make_shared< RawKeyword >( keywordString, rawSizeType,
-                                                parserState.current_path().string(),
+                                                parserState.current_name(),
                                                 parserState.line() );
     }
 
     if( parserKeyword->hasFixedSize() ) {
         return std::make_shared< RawKeyword >( keywordString,
-                                                parserState.current_path().string(),
+                                                parserState.current_name(),
                                                 parserState.line(),
                                                 parserKeyword->getFixedSize(),
                                                 parserKeyword->isTableCollection() );
@@ -457,12 +933,16 @@ std::shared_ptr< RawKeyword > createRawKeyword( const string_view& kw, ParserSta
         const auto& record = sizeDefinitionKeyword.getRecord(0);
         const auto targetSize = record.getItem( keyword_size.item ).get< int >( 0 ) + keyword_size.shift;
         return std::make_shared< RawKeyword >( keywordString,
-                                                parserState.current_path().string(),
+                                                parserState.current_name(),
                                                 parserState.line(),
                                                 targetSize,
                                                 parserKeyword->isTableCollection() );
     }
 
+    /* the size keyword could have been defined before the include */
+    if( parserState.speculative )
+        throw speculation_failed();
+
     std::string msg = "Expected the kewyord: " +keyword_size.keyword 
                     + " to infer the number of records in: " + keywordString;
     auto& msgContainer = parserState.deck.getMessageContainer();
@@ -474,7 +954,7 @@ std::shared_ptr< RawKeyword > createRawKeyword( const string_view& kw, ParserSta
 
     const auto targetSize = int_item.getDefault< int >( ) + keyword_size.shift;
     return std::make_shared< RawKeyword >( keywordString,
-                                            parserState.current_path().string(),
+                                            parserState.current_name(),
                                             parserState.line(),
                                             targetSize,
                                             parserKeyword->isTableCollection() );
@@ -486,6 +966,12 @@ bool tryParseKeyword( ParserState& parserState, const Parser& parser ) {
         parserState.nextKeyword = emptystr;
     }
 
+    /*
+     * The previous keyword has been added to the deck, and nothing views into
+     * files which were closed while it was being read any longer.
+     */
+    parserState.releaseClosedFiles();
+
     if (parserState.rawKeyword && parserState.rawKeyword->isFinished())
         return true;
 
@@ -550,8 +1036,17 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
         if( !parserState.rawKeyword && !streamOK )
             continue;
 
-        if (parserState.rawKeyword->getKeywordName() == Opm::RawConsts::end)
+        /*
+         * A keyword which is not finished at the end of an include file
+         * continues in the including file.
+         */
+        if( !streamOK && parserState.speculative )
+            throw speculation_failed();
+
+        if (parserState.rawKeyword->getKeywordName() == Opm::RawConsts::end) {
+            if( parserState.speculative ) throw speculation_failed();
             return true;
+        }
 
         if (parserState.rawKeyword->getKeywordName() == Opm::RawConsts::endinclude) {
             parserState.closeFile();
@@ -559,6 +1054,8 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
         }
 
         if (parserState.rawKeyword->getKeywordName() == Opm::RawConsts::paths) {
+            if( parserState.speculative ) throw speculation_failed();
+
             for( const auto& record : *parserState.rawKeyword ) {
                 std::string pathName = readValueToken<std::string>(record.getItem(0));
                 std::string pathValue = readValueToken<std::string>(record.getItem(1));
@@ -573,28 +1070,140 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
             std::string includeFileAsString = readValueToken<std::string>(firstRecord.getItem(0));
             boost::filesystem::path includeFile = parserState.getIncludeFilePath( includeFileAsString );
 
+            if( parserState.includes && parserState.includes->splice( includeFile, parserState ) )
+                continue;
+
             parserState.loadFile( includeFile );
             continue;
         }
 
-        if( parser.isRecognizedKeyword( parserState.rawKeyword->getKeywordName() ) ) {
-            const auto& kwname = parserState.rawKeyword->getKeywordName();
+        const auto& kwname = parserState.rawKeyword->getKeywordName();
+        if( parserState.stream && !parserState.stream->accept( kwname, parserState.deck ) )
+            continue;
+
+        if( parser.isRecognizedKeyword( kwname ) ) {
             const auto* parserKeyword = parser.getParserKeywordFromDeckName( kwname );
-            parserState.deck.addKeyword( parserKeyword->parse( parserState.parseContext, parserState.deck.getMessageContainer(), parserState.rawKeyword ) );
+            parserState.addKeyword( parserKeyword->parse( parserState.parseContext, parserState.deck.getMessageContainer(), parserState.rawKeyword ) );
         } else {
             DeckKeyword deckKeyword( parserState.rawKeyword->getKeywordName(), false );
             const std::string msg = "The keyword " + parserState.rawKeyword->getKeywordName() + " is not recognized";
-            deckKeyword.setLocation( parserState.rawKeyword->getFilename(),
+            deckKeyword.setLocation( parserState.rawKeyword->getSharedFilename(),
                     parserState.rawKeyword->getLineNR());
-            parserState.deck.addKeyword( std::move( deckKeyword ) );
+            parserState.addKeyword( std::move( deckKeyword ) );
             parserState.deck.getMessageContainer().warning(
                 parserState.current_path().string(), msg, parserState.line() );
         }
+
+        /*
+         * With a KeywordVisitor the keyword has now been visited, and its
+         * records are not read again; the only view into the input which
+         * is still live is nextKeyword. This is the only place the parsed
+         * input is given back, a deck parse keeps all of it mapped.
+         */
+        if( parserState.stream )
+            parserState.discardConsumedInput();
     }
 
     return true;
 }
 
+IncludeParser::IncludeParser( const Parser& p,
+                              const ParseContext& ctx,
+                              const boost::filesystem::path& rootPath,
+                              size_t threads ) :
+    parser( p ),
+    context( ctx ),
+    root( rootPath ),
+    num_threads( threads ),
+    next( 0 ),
+    cancelled( false )
+{}
+
+IncludeParser::~IncludeParser() {
+    this->cancelled = true;
+    for( auto& worker : this->workers )
+        worker.join();
+}
+
+void IncludeParser::add( const boost::filesystem::path& path,
+                         const std::map< std::string, std::string >& aliases ) {
+    std::unique_ptr< job > j( new job );
+    j->path = path;
+    j->aliases = aliases;
+    j->ready = j->done.get_future();
+    this->jobs.push_back( std::move( j ) );
+}
+
+void IncludeParser::start() {
+    const auto threads = std::min( this->num_threads, this->jobs.size() );
+    for( size_t i = 0; i < threads; ++i )
+        this->workers.emplace_back( &IncludeParser::work, this );
+}
+
+void IncludeParser::work() {
+    for( auto index = this->next++;
+         index < this->jobs.size() && !this->cancelled;
+         index = this->next++ ) {
+        this->parse( *this->jobs[ index ] );
+    }
+}
+
+void IncludeParser::parse( job& j ) const {
+    try {
+        std::unique_ptr< ParserState > state( new ParserState( this->context ) );
+        state->speculative = true;
+        state->loadInclude( j.path, this->root, j.aliases );
+        parseState( *state, this->parser );
+        state->releaseClosedFiles();
+
+        /*
+         * How text following the include is interpreted depends on the last
+         * keyword seen, which must then be in the include file itself.
+         */
+        if( !state->lastKeyWord.empty() && state->nextKeyword.length() == 0 )
+            j.state = std::move( state );
+    } catch( ... ) {
+        /*
+         * Errors are reported when the file is parsed serially, which
+         * either fails the same way or reports them in the right order.
+         */
+    }
+
+    j.done.set_value();
+}
+
+/*
+ * Append the keywords of a file which has been parsed by a worker to the
+ * parser state's deck. Returns false if the file must be parsed serially.
+ */
+bool IncludeParser::splice( const boost::filesystem::path& path, ParserState& parserState ) {
+    const auto& aliases = parserState.pathAliases();
+    auto match = std::find_if( this->jobs.begin() + this->current, this->jobs.end(),
+                               [&]( const std::unique_ptr< job >& j ) {
+                                   return j->path == path && j->aliases == aliases;
+                               } );
+
+    if( match == this->jobs.end() ) return false;
+    this->current = std::distance( this->jobs.begin(), match ) + 1;
+
+    auto& j = **match;
+    j.ready.wait();
+    if( !j.state ) return false;
+
+    auto& include = *j.state;
+    parserState.deck.getMessageContainer().appendMessages( include.deck.getMessageContainer() );
+    for( auto& keyword : include.deck )
+        parserState.deck.addKeyword( std::move( keyword ) );
+
+    parserState.addFiles( include.files() );
+    parserState.unknown_keyword = include.unknown_keyword;
+    parserState.lastSizeType = include.lastSizeType;
+    parserState.lastKeyWord = include.lastKeyWord;
+
+    j.state.reset();
+    return true;
+}
+
 }
 
 
@@ -606,7 +1215,11 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
                  find_terminator( str.begin(), str.end(), find_comment() ) };
     }
 
-    Parser::Parser(bool addDefault) {
+    Parser::Parser(bool addDefault) :
+        m_deckNameHash( defaultDeckNames() ),
+        m_hashedKeywords( m_deckNameHash.size() ),
+        m_wildCardTrie( 1 )
+    {
         if (addDefault)
             addDefaultKeywords();
     }
@@ -672,6 +1285,49 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
         return std::move( parserState.deck );
     }
 
+    Deck Parser::parseFile(const std::string &dataFileName, const ParseContext& parseContext, size_t threads) const {
+        if( threads < 2 )
+            return this->parseFile( dataFileName, parseContext );
+
+        ParserState parserState( parseContext, dataFileName );
+        IncludeParser includes( *this, parseContext,
+                                boost::filesystem::canonical( dataFileName ).parent_path(),
+                                threads );
+
+        parserState.prefetchIncludes( includes );
+        parserState.includes = &includes;
+        includes.start();
+
+        parseState( parserState, *this );
+        applyUnitsToDeck( parserState.deck );
+
+        return std::move( parserState.deck );
+    }
+
+    Deck Parser::parseFile(const std::string &dataFileName, const ParseContext& parseContext, const DeckCache& cache) const {
+        Deck deck;
+        if( cache.load( dataFileName, *this, parseContext, deck ) )
+            return deck;
+
+        ParserState parserState( parseContext, dataFileName );
+        parseState( parserState, *this );
+        applyUnitsToDeck( parserState.deck );
+        cache.store( parserState.deck, parserState.files(), *this, parseContext );
+
+        return std::move( parserState.deck );
+    }
+
+    MessageContainer Parser::parseFile(const std::string &dataFileName, const ParseContext& parseContext, KeywordVisitor& visitor) const {
+        ParserState parserState( parseContext, dataFileName );
+        KeywordStream stream( *this, visitor );
+        parserState.stream = &stream;
+
+        parseState( parserState, *this );
+        stream.finish( parserState.deck );
+
+        return parserState.deck.getMessageContainer();
+    }
+
     Deck Parser::parseString(const std::string &data, const ParseContext& parseContext) const {
         ParserState parserState( parseContext );
         parserState.loadString( data );
@@ -683,15 +1339,92 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
     }
 
     size_t Parser::size() const {
-        return m_deckParserKeywords.size();
+        const auto hashed = std::count_if( m_hashedKeywords.begin(), m_hashedKeywords.end(),
+            []( const hashed_keyword& entry ) { return entry.factory || entry.keyword.load(); } );
+
+        return size_t( hashed ) + m_unhashedDeckNames;
     }
 
+    /*
+     * Of the wildcard keywords which match the name, the one first by name.
+     * Only the keywords found along the path of the name in the prefix trie
+     * can match it.
+     */
     const ParserKeyword* Parser::matchingKeyword(const string_view& name) const {
-        for (auto iter = m_wildCardKeywords.begin(); iter != m_wildCardKeywords.end(); ++iter) {
-            if (iter->second->matches(name))
-                return iter->second;
+        const ParserKeyword* match = nullptr;
+        const auto consider = [&]( const wildcard_node& node ) {
+            for( const auto* keyword : node.keywords ) {
+                if( match && match->getName() < keyword->getName() ) continue;
+                if( keyword->matches( name ) ) match = keyword;
+            }
+        };
+
+        const auto* node = &this->m_wildCardTrie.front();
+        consider( *node );
+
+        for( const char c : name ) {
+            const auto child = node->children.find( c );
+            if( child == node->children.end() ) break;
+
+            node = &this->m_wildCardTrie[ child->second ];
+            consider( *node );
         }
-        return nullptr;
+
+        return match;
+    }
+
+    void Parser::addWildCardKeyword( const ParserKeyword* keyword ) {
+        const string_view name( keyword->getName() );
+
+        const auto previous = this->m_wildCardKeywords.find( name );
+        if( previous != this->m_wildCardKeywords.end() ) {
+            for( auto& node : this->m_wildCardTrie ) {
+                auto& kws = node.keywords;
+                kws.erase( std::remove( kws.begin(), kws.end(), previous->second ), kws.end() );
+            }
+        }
+
+        this->m_wildCardKeywords[ name ] = keyword;
+
+        for( const auto& prefix : regex_prefixes( keyword->getMatchRegex() ) ) {
+            size_t node = 0;
+            for( const char c : prefix ) {
+                const auto child = this->m_wildCardTrie[ node ].children.find( c );
+                if( child != this->m_wildCardTrie[ node ].children.end() ) {
+                    node = child->second;
+                    continue;
+                }
+
+                this->m_wildCardTrie[ node ].children.emplace( c, this->m_wildCardTrie.size() );
+                node = this->m_wildCardTrie.size();
+                this->m_wildCardTrie.emplace_back();
+            }
+
+            auto& kws = this->m_wildCardTrie[ node ].keywords;
+            if( std::find( kws.begin(), kws.end(), keyword ) == kws.end() )
+                kws.push_back( keyword );
+        }
+    }
+
+    /*
+     * The keyword of a deck name. Names known at build time are looked up in
+     * the perfect hash, and only names which were added later are looked up
+     * in the map.
+     */
+    const ParserKeyword* Parser::deckKeyword( const string_view& name ) const {
+        const auto slot = this->m_deckNameHash.slot( name );
+        if( slot >= 0 ) {
+            const auto& entry = this->m_hashedKeywords[ slot ];
+            const auto* keyword = entry.keyword.load( std::memory_order_acquire );
+            return keyword ? keyword : this->createKeyword( entry );
+        }
+
+        if( this->m_unhashedDeckNames == 0 ) return nullptr;
+
+        const auto candidate = this->m_deckParserKeywords.find( name );
+        if( candidate == this->m_deckParserKeywords.end() ) return nullptr;
+
+        return candidate->second;
     }
 
     bool Parser::hasWildCardKeyword(const std::string& internalKeywordName) const {
@@ -702,7 +1435,7 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
         if( !ParserKeyword::validDeckName( name ) )
             return false;
 
-        if( m_deckParserKeywords.count( name ) )
+        if( deckKeyword( name ) )
             return true;
 
         return bool( matchingKeyword( name ) );
@@ -735,23 +1468,82 @@ void Parser::addParserKeyword( std::unique_ptr< const ParserKeyword >&& parserKe
             nameIt != ptr->deckNamesEnd();
             ++nameIt)
     {
-        m_deckParserKeywords[ *nameIt ] = ptr;
+        const auto inserted = m_deckParserKeywords.emplace( *nameIt, ptr );
+        if( !inserted.second ) inserted.first->second = ptr;
+
+        const auto slot = m_deckNameHash.slot( *nameIt );
+        if( slot >= 0 ) {
+            m_hashedKeywords[ slot ].keyword.store( ptr );
+            m_hashedKeywords[ slot ].factory = nullptr;
+        }
+        else if( inserted.second )
+            ++m_unhashedDeckNames;
     }
 
     if (ptr->hasMatchRegex()) {
-        m_wildCardKeywords[ name ] = ptr;
+        addWildCardKeyword( ptr );
+    }
+
+}
+
+
+/*
+ * Construct the built-in keyword of entry, and make it the keyword of all of
+ * its deck names which have not been given another keyword since.
+ */
+const ParserKeyword* Parser::createKeyword( const hashed_keyword& entry ) const {
+    if( !entry.factory ) return nullptr;
+
+    std::lock_guard< std::mutex > lock( *this->m_createMutex );
+
+    const auto* existing = entry.keyword.load( std::memory_order_acquire );
+    if( existing ) return existing;
+
+    const auto* factory = entry.factory;
+    auto keyword = factory->create();
+
+    for( auto name = keyword->deckNamesBegin(); name != keyword->deckNamesEnd(); ++name ) {
+        const auto slot = this->m_deckNameHash.slot( *name );
+        if( slot < 0 ) continue;
+
+        auto& other = const_cast< hashed_keyword& >( this->m_hashedKeywords[ slot ] );
+        if( other.factory == factory && !other.keyword.load( std::memory_order_relaxed ) )
+            other.keyword.store( keyword.get(), std::memory_order_release );
     }
 
+    this->m_createdKeywords.push_back( std::move( keyword ) );
+    return entry.keyword.load( std::memory_order_acquire );
 }
 
+/*
+ * Register a built-in keyword without constructing it. Keywords which can not
+ * be found through the perfect hash alone are added right away.
+ */
+void Parser::addKeywordFactory( const KeywordFactory& factory ) {
+    std::vector< int > slots;
+    if( !factory.wildcard ) {
+        std::stringstream names( factory.deckNames );
+        for( std::string name; names >> name; )
+            slots.push_back( m_deckNameHash.slot( name ) );
+    }
+
+    if( slots.empty() || std::count( slots.begin(), slots.end(), -1 ) > 0 ) {
+        addParserKeyword( factory.create() );
+        return;
+    }
+
+    for( const auto slot : slots ) {
+        m_hashedKeywords[ slot ].keyword.store( nullptr );
+        m_hashedKeywords[ slot ].factory = &factory;
+    }
+}
 
 void Parser::addParserKeyword(const Json::JsonObject& jsonKeyword) {
     addParserKeyword( std::unique_ptr< ParserKeyword >( new ParserKeyword( jsonKeyword ) ) );
 }
 
 bool Parser::hasKeyword( const std::string& name ) const {
-    return this->m_deckParserKeywords.find( string_view( name ) )
-        != this->m_deckParserKeywords.end();
+    return deckKeyword( string_view( name ) ) != nullptr;
 }
 
 const ParserKeyword* Parser::getKeyword( const std::string& name ) const {
@@ -759,9 +1551,9 @@ const ParserKeyword* Parser::getKeyword( const std::string& name ) const {
 }
 
 const ParserKeyword* Parser::getParserKeywordFromDeckName(const string_view& name ) const {
-    auto candidate = m_deckParserKeywords.find( name );
+    const auto* candidate = deckKeyword( name );
 
-    if( candidate != m_deckParserKeywords.end() ) return candidate->second;
+    if( candidate ) return candidate;
 
     const auto* wildCardKeyword = matchingKeyword( name );
 
@@ -773,9 +1565,17 @@ const ParserKeyword* Parser::getParserKeywordFromDeckName(const string_view& nam
 
 std::vector<std::string> Parser::getAllDeckNames () const {
     std::vector<std::string> keywords;
+    for( size_t slot = 0; slot < m_hashedKeywords.size(); ++slot ) {
+        const auto& entry = m_hashedKeywords[ slot ];
+        if( entry.factory || entry.keyword.load() )
+            keywords.push_back( m_deckNameHash.name( slot ) );
+    }
     for (auto iterator = m_deckParserKeywords.begin(); iterator != m_deckParserKeywords.end(); iterator++) {
-        keywords.push_back(iterator->first.string());
+        if( m_deckNameHash.slot( iterator->first ) < 0 )
+            keywords.push_back(iterator->first.string());
     }
+    std::sort( keywords.begin(), keywords.end() );
+
     for (auto iterator = m_wildCardKeywords.begin(); iterator != m_wildCardKeywords.end(); iterator++) {
         keywords.push_back(iterator->first.string());
     }
@@ -783,6 +1583,33 @@ std::vector<std::string> Parser::getAllDeckNames () const {
 }
 
 
+uint64_t Parser::definitionHash() const {
+    std::string id;
+    const auto add = [&id]( const std::string& name, uint64_t definition ) {
+        id += name + ' ' + std::to_string( definition ) + '\n';
+    };
+
+    for( size_t slot = 0; slot < m_hashedKeywords.size(); ++slot ) {
+        const auto& entry = m_hashedKeywords[ slot ];
+        const auto* keyword = entry.keyword.load();
+        if( entry.factory )
+            add( m_deckNameHash.name( slot ), entry.factory->definition );
+        else if( keyword )
+            add( m_deckNameHash.name( slot ), keyword->definitionHash() );
+    }
+
+    for( const auto& keyword : m_deckParserKeywords ) {
+        if( m_deckNameHash.slot( keyword.first ) < 0 )
+            add( keyword.first.string(), keyword.second->definitionHash() );
+    }
+
+    for( const auto& keyword : m_wildCardKeywords )
+        add( keyword.first.string(), keyword.second->definitionHash() );
+
+    return DeckCache::hash( id.data(), id.size() );
+}
+
+
     void Parser::loadKeywords(const Json::JsonObject& jsonKeywords) {
         if (jsonKeywords.is_array()) {
             for (size_t index = 0; index < jsonKeywords.size(); index++) {
@@ -827,36 +1654,14 @@ std::vector<std::string> Parser::getAllDeckNames () const {
 
 
     void Parser::applyUnitsToDeck(Deck& deck) const {
-        /*
-         * If multiple unit systems are requested, metric is preferred over
-         * lab, and field over metric, for as long as we have no easy way of
-         * figuring out which was requested last.
-         */
-        if( deck.hasKeyword( "LAB" ) )
-            deck.getActiveUnitSystem() = UnitSystem::newLAB();
-        if( deck.hasKeyword( "FIELD" ) )
-            deck.getActiveUnitSystem() = UnitSystem::newFIELD();
-        if( deck.hasKeyword( "METRIC" ) )
-            deck.getActiveUnitSystem() = UnitSystem::newMETRIC();
+        select_unit_system( deck );
 
-        for( auto& deckKeyword : deck ) {
-
-            if( !isRecognizedKeyword( deckKeyword.name() ) ) continue;
-
-            const auto* parserKeyword = getParserKeywordFromDeckName( deckKeyword.name() );
-            if( !parserKeyword->hasDimension() ) continue;
-
-            parserKeyword->applyUnitsToDeck(deck , deckKeyword);
-        }
+        for( auto& deckKeyword : deck )
+            apply_units( *this, deck, deckKeyword );
     }
 
     static bool isSectionDelimiter( const DeckKeyword& keyword ) {
-        const auto& name = keyword.name();
-        for( const auto& x : { "RUNSPEC", "GRID", "EDIT", "PROPS",
-                               "REGIONS", "SOLUTION", "SUMMARY", "SCHEDULE" } )
-            if( name == x ) return true;
-
-        return false;
+        return is_section_name( keyword.name() );
     }
 
     bool Section::checkSectionTopology(const Deck& deck,
@@ -17,6 +17,8 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cstdint>
 #include <ostream>
 #include <sstream>
 
@@ -26,6 +28,7 @@
 
 #include <opm/parser/eclipse/Parser/ParserItem.hpp>
 #include <opm/parser/eclipse/Parser/ParserEnums.hpp>
+#include <opm/parser/eclipse/RawDeck/RawConsts.hpp>
 #include <opm/parser/eclipse/RawDeck/RawRecord.hpp>
 #include <opm/parser/eclipse/RawDeck/StarToken.hpp>
 
@@ -355,33 +358,197 @@ std::string ParserItem::createCode() const {
 namespace {
 
 template< typename T >
-DeckItem scan_item( const ParserItem& p, RawRecord& record ) {
-    DeckItem item( p.name(), T(), record.size() );
+void scan_token( const ParserItem& p, DeckItem& item, const string_view& token ) {
+    std::string countString;
+    std::string valueString;
 
-    if( p.sizeType() == ParserItem::item_size::ALL ) {
-        while( record.size() > 0 ) {
-            auto token = record.pop_front();
+    if( !isStarToken( token, countString, valueString ) ) {
+        item.push_back( readValueToken< T >( token ) );
+        return;
+    }
 
-            std::string countString;
-            std::string valueString;
+    StarToken st(token, countString, valueString);
 
-            if( !isStarToken( token, countString, valueString ) ) {
-                item.push_back( readValueToken< T >( token ) );
-                continue;
-            }
+    if( st.hasValue() ) {
+        item.push_back( readValueToken< T >( st.valueString() ), st.count() );
+        return;
+    }
+
+    auto value = p.getDefault< T >();
+    for (size_t i=0; i < st.count(); i++)
+        item.push_backDefault( value );
+}
+
+/*
+ * Bulk scanning of items of size ALL, which is what the large data keywords
+ * like ZCORN, COORD and PORO consist of. The record string is scanned
+ * directly instead of being split into a deque of tokens first, and the
+ * common number formats are converted inline. Everything else - numbers the
+ * fast path can not convert exactly, odd repetition counts and malformed
+ * tokens - is handed to scan_token, so the result and the errors are the same
+ * as when scanning the record token by token.
+ */
+
+inline bool is_digit( char ch ) {
+    return unsigned( ch - '0' ) <= 9;
+}
+
+/*
+ * Integers of at most nine digits, which can not overflow.
+ */
+inline bool fast_value( const char* begin, const char* end, int& value ) {
+    const bool negative = *begin == '-';
+    if( *begin == '-' || *begin == '+' ) ++begin;
+
+    if( begin == end || end - begin > 9 ) return false;
+
+    int n = 0;
+    for( ; begin != end; ++begin ) {
+        if( !is_digit( *begin ) ) return false;
+        n = n * 10 + ( *begin - '0' );
+    }
+
+    value = negative ? -n : n;
+    return true;
+}
+
+/*
+ * Decimal numbers, with or without a (Fortran style) exponent, whose digits
+ * form an integer of at most 2^53 and which have a decimal exponent of at
+ * most 22 in magnitude. Both the digits and the power of ten are then exact
+ * doubles, and the value is a single, correctly rounded, multiplication or
+ * division. This is also how the general number parser computes them.
+ */
+constexpr double exact_powers_of_ten[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+inline bool fast_value( const char* begin, const char* end, double& value ) {
+    const bool negative = *begin == '-';
+    if( *begin == '-' || *begin == '+' ) ++begin;
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+
+    for( ; begin != end && is_digit( *begin ); ++begin, ++digits )
+        mantissa = mantissa * 10 + ( *begin - '0' );
+
+    if( begin != end && *begin == '.' ) {
+        for( ++begin; begin != end && is_digit( *begin ); ++begin, ++digits, --exponent )
+            mantissa = mantissa * 10 + ( *begin - '0' );
+    }
+
+    if( digits == 0 || digits > 19 ) return false;
+
+    if( begin != end ) {
+        if( *begin != 'e' && *begin != 'E' && *begin != 'd' && *begin != 'D' )
+            return false;
 
-            StarToken st(token, countString, valueString);
+        ++begin;
+        const bool negative_exponent = begin != end && *begin == '-';
+        if( begin != end && ( *begin == '-' || *begin == '+' ) ) ++begin;
 
-            if( st.hasValue() ) {
-                item.push_back( readValueToken< T >( st.valueString() ), st.count() );
+        if( begin == end || end - begin > 3 ) return false;
+
+        int exp = 0;
+        for( ; begin != end; ++begin ) {
+            if( !is_digit( *begin ) ) return false;
+            exp = exp * 10 + ( *begin - '0' );
+        }
+
+        exponent += negative_exponent ? -exp : exp;
+    }
+
+    if( mantissa > ( uint64_t( 1 ) << 53 ) || exponent < -22 || exponent > 22 )
+        return false;
+
+    double x = double( mantissa );
+    x = exponent < 0 ? x / exact_powers_of_ten[ -exponent ]
+                     : x * exact_powers_of_ten[ exponent ];
+
+    value = negative ? -x : x;
+    return true;
+}
+
+/*
+ * The number of tokens in the record, i.e. the number of values not counting
+ * repetitions, used to size the item up front.
+ */
+inline size_t count_tokens( const string_view& data ) {
+    const auto is_separator = RawConsts::is_separator();
+
+    size_t count = 0;
+    bool in_token = false;
+    for( const char ch : data ) {
+        const bool sep = is_separator( ch );
+        count += !sep && !in_token;
+        in_token = !sep;
+    }
+
+    return count;
+}
+
+template< typename T >
+DeckItem scan_all( const ParserItem& p, const string_view& data ) {
+    const auto is_separator = RawConsts::is_separator();
+    DeckItem item( p.name(), T(), count_tokens( data ) );
+
+    auto cursor = data.begin();
+    const auto end = data.end();
+
+    while( true ) {
+        cursor = std::find_if_not( cursor, end, is_separator );
+        if( cursor == end ) break;
+
+        const auto token_end = std::find_if( cursor, end, is_separator );
+        const string_view token( cursor, token_end );
+        cursor = token_end;
+
+        T value;
+        if( fast_value( token.begin(), token.end(), value ) ) {
+            item.push_back( value );
+            continue;
+        }
+
+        /* N*value or N*, with a count of at most nine digits */
+        const auto star = std::find_if_not( token.begin(), token.end(), is_digit );
+        const auto count_digits = star - token.begin();
+
+        if( star != token.end() && *star == '*' && count_digits > 0 && count_digits <= 9 ) {
+            size_t count = 0;
+            for( auto itr = token.begin(); itr != star; ++itr )
+                count = count * 10 + ( *itr - '0' );
+
+            if( count > 0 && star + 1 == token.end() ) {
+                const auto& def = p.getDefault< T >();
+                for( size_t i = 0; i < count; ++i )
+                    item.push_backDefault( def );
                 continue;
             }
 
-            auto value = p.getDefault< T >();
-            for (size_t i=0; i < st.count(); i++)
-                item.push_backDefault( value );
+            if( count > 0 && fast_value( star + 1, token.end(), value ) ) {
+                item.push_back( value, count );
+                continue;
+            }
         }
 
+        scan_token< T >( p, item, token );
+    }
+
+    return item;
+}
+
+template< typename T >
+DeckItem scan_item( const ParserItem& p, RawRecord& record ) {
+    DeckItem item( p.name(), T(), record.size() );
+
+    if( p.sizeType() == ParserItem::item_size::ALL ) {
+        while( record.size() > 0 )
+            scan_token< T >( p, item, record.pop_front() );
+
         return item;
     }
 
@@ -440,10 +607,16 @@ DeckItem scan_item( const ParserItem& p, RawRecord& record ) {
 /// returns a DeckItem object.
 /// NOTE: data are popped from the records deque!
 DeckItem ParserItem::scan( RawRecord& record ) const {
+    string_view data;
+
     switch( this->type ) {
         case type_tag::integer:
+            if( this->sizeType() == item_size::ALL && record.popRecordString( data ) )
+                return scan_all< int >( *this, data );
             return scan_item< int >( *this, record );
         case type_tag::fdouble:
+            if( this->sizeType() == item_size::ALL && record.popRecordString( data ) )
+                return scan_all< double >( *this, data );
             return scan_item< double >( *this, record );
         case type_tag::string:
             return scan_item< std::string >( *this, record );
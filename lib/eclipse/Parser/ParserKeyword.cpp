@@ -482,7 +482,7 @@ void set_dimensions( ParserItem& item,
             throw std::invalid_argument("Tried to create a deck keyword from an incomplete raw keyword " + rawKeyword->getKeywordName());
 
         DeckKeyword keyword( rawKeyword->getKeywordName() );
-        keyword.setLocation( rawKeyword->getFilename(), rawKeyword->getLineNR() );
+        keyword.setLocation( rawKeyword->getSharedFilename(), rawKeyword->getLineNR() );
         keyword.setDataKeyword( isDataKeyword() );
 
         size_t record_nr = 0;
@@ -538,6 +538,10 @@ void set_dimensions( ParserItem& item,
         return !m_matchRegexString.empty();
     }
 
+    const std::string& ParserKeyword::getMatchRegex() const {
+        return m_matchRegexString;
+    }
+
     void ParserKeyword::setMatchRegex(const std::string& deckNameRegexp) {
         try {
             m_matchRegex = boost::regex(deckNameRegexp);
@@ -691,6 +695,19 @@ void set_dimensions( ParserItem& item,
     }
 
 
+    uint64_t ParserKeyword::definitionHash() const {
+        /* FNV-1a */
+        const auto code = this->createCode();
+        uint64_t h = 14695981039346656037ULL;
+        for( const char c : code ) {
+            h ^= static_cast< unsigned char >( c );
+            h *= 1099511628211ULL;
+        }
+
+        return h;
+    }
+
+
     void ParserKeyword::applyUnitsToDeck( Deck& deck, DeckKeyword& deckKeyword) const {
         for (size_t index = 0; index < deckKeyword.size(); index++) {
             const auto& parserRecord = this->getRecord( index );
@@ -99,6 +99,8 @@ namespace {
                 auto defaultDimension = deck.getDefaultUnitSystem().getNewDimension( item.getDimension(idim) );
                 deckItem.push_backDimension( activeDimension , defaultDimension );
             }
+
+            deckItem.convertToSI();
         }
     }
 
@@ -30,23 +30,32 @@ namespace Opm {
     static const std::string emptystr = "";
 
     RawKeyword::RawKeyword(const string_view& name, Raw::KeywordSizeEnum sizeType , const std::string& filename, size_t lineNR) :
+        RawKeyword( name, sizeType, std::make_shared< const std::string >( filename ), lineNR )
+    {}
+
+    RawKeyword::RawKeyword(const string_view& name , const std::string& filename, size_t lineNR , size_t inputSize, bool isTableCollection ) :
+        RawKeyword( name, std::make_shared< const std::string >( filename ), lineNR, inputSize, isTableCollection )
+    {}
+
+    RawKeyword::RawKeyword(const string_view& name, Raw::KeywordSizeEnum sizeType , std::shared_ptr< const std::string > filename, size_t lineNR) :
         m_partialRecordString( emptystr )
     {
         if (sizeType == Raw::SLASH_TERMINATED || sizeType == Raw::UNKNOWN) {
-            commonInit(name.string(),filename,lineNR);
+            commonInit(name.string(),std::move(filename),lineNR);
             m_sizeType = sizeType;
         } else
             throw std::invalid_argument("Error - invalid sizetype on input");
     }
 
-    RawKeyword::RawKeyword(const string_view& name , const std::string& filename, size_t lineNR , size_t inputSize, bool isTableCollection ) {
-        commonInit(name.string(),filename,lineNR);
+    RawKeyword::RawKeyword(const string_view& name , std::shared_ptr< const std::string > filename, size_t lineNR , size_t inputSize, bool isTableCollection ) {
+        commonInit(name.string(),std::move(filename),lineNR);
         if (isTableCollection) {
             m_sizeType = Raw::TABLE_COLLECTION;
             m_numTables = inputSize;
         } else {
             m_sizeType = Raw::FIXED;
             m_fixedSize = inputSize;
+            m_records.reserve( m_fixedSize );
             if (m_fixedSize == 0)
                 m_isFinished = true;
             else
@@ -55,9 +64,9 @@ namespace Opm {
     }
 
 
-    void RawKeyword::commonInit(const std::string& name , const std::string& filename, size_t lineNR) {
+    void RawKeyword::commonInit(const std::string& name , std::shared_ptr< const std::string > filename, size_t lineNR) {
         setKeywordName( name );
-        m_filename = filename;
+        m_filename = std::move( filename );
         m_lineNR = lineNR;
 
         this->m_is_title = name == "TITLE";
@@ -173,6 +182,10 @@ namespace Opm {
     }
 
     const std::string& RawKeyword::getFilename() const {
+        return *m_filename;
+    }
+
+    const std::shared_ptr< const std::string >& RawKeyword::getSharedFilename() const {
         return m_filename;
     }
 
@@ -21,11 +21,11 @@
 #include <iostream>
 #include <stdexcept>
 #include <vector>
-#include <deque>
 
 #include <opm/parser/eclipse/RawDeck/RawRecord.hpp>
 #include <opm/parser/eclipse/RawDeck/RawConsts.hpp>
 
+#include <opm/parser/eclipse/Utility/Intern.hpp>
 #include <opm/parser/eclipse/Utility/Stringview.hpp>
 
 using namespace Opm;
@@ -35,13 +35,19 @@ namespace Opm {
 
 namespace {
 
-std::deque< string_view > splitSingleRecordString( const string_view& record ) {
+std::vector< string_view > splitSingleRecordString( const string_view& record ) {
     auto first_nonspace = []( string_view::const_iterator begin,
                               string_view::const_iterator end ) {
         return std::find_if_not( begin, end, RawConsts::is_separator() );
     };
 
-    std::deque< string_view > dst;
+    /*
+     * The tokens are collected in a per-thread scratch buffer which is
+     * reused between records, so that the record only does one
+     * allocation of the exact size.
+     */
+    static thread_local std::vector< string_view > dst;
+    dst.clear();
     auto current = record.begin();
     while( (current = first_nonspace( current, record.end() )) != record.end() )
     {
@@ -56,7 +62,7 @@ std::deque< string_view > splitSingleRecordString( const string_view& record ) {
         }
     }
 
-    return dst;
+    return { dst.begin(), dst.end() };
 }
 
 /*
@@ -77,12 +83,11 @@ inline bool even_quotes( const T& str ) {
 }
 
     RawRecord::RawRecord(const string_view& singleRecordString,
-                         const std::string& fileName,
+                         std::shared_ptr< const std::string > fileName,
                          const std::string& keywordName) :
         m_sanitizedRecordString( singleRecordString ),
-        m_recordItems( splitSingleRecordString( m_sanitizedRecordString ) ),
-        m_fileName(fileName),
-        m_keywordName(keywordName)
+        m_fileName( std::move( fileName ) ),
+        m_keywordName( &intern( keywordName ) )
     {
 
         if( !even_quotes( singleRecordString ) )
@@ -92,25 +97,47 @@ inline bool even_quotes( const T& str ) {
             );
     }
 
+    RawRecord::RawRecord(const string_view& singleRecordString,
+                         const std::string& fileName,
+                         const std::string& keywordName) :
+        RawRecord( singleRecordString, std::make_shared< const std::string >( fileName ), keywordName )
+    {}
+
     const std::string& RawRecord::getFileName() const {
-        return m_fileName;
+        static const std::string nofile;
+        return m_fileName ? *m_fileName : nofile;
     }
 
     const std::string& RawRecord::getKeywordName() const {
-        return m_keywordName;
+        return *m_keywordName;
+    }
+
+    void RawRecord::split() const {
+        this->m_recordItems = splitSingleRecordString( m_sanitizedRecordString );
+        this->m_split = true;
+    }
+
+    bool RawRecord::popRecordString( string_view& str ) {
+        if( this->m_split ) return false;
+
+        str = this->m_sanitizedRecordString;
+        this->m_split = true;
+        return true;
     }
 
     void RawRecord::prepend( size_t count, string_view tok ) {
-        this->m_recordItems.insert( this->m_recordItems.begin(), count, tok );
+        if( !this->m_split ) this->split();
+        if( count == 0 ) return;
+
+        this->m_prepended.emplace_back( tok, count );
+        this->m_numPrepended += count;
     }
 
     void RawRecord::dump() const {
         std::cout << "RecordDump: ";
-        for (size_t i = 0; i < m_recordItems.size(); i++) {
-            std::cout
-                << this->m_recordItems[i] << "/"
-                << getItem( i ) << " ";
-        }
+        for (size_t i = 0; i < this->size(); i++)
+            std::cout << getItem( i ) << " ";
+
         std::cout << std::endl;
     }
 
@@ -0,0 +1,75 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+
+#include <opm/parser/eclipse/Utility/Intern.hpp>
+
+namespace Opm {
+
+namespace {
+
+    /*
+     * The per-thread caches are sets of pointers to the interned
+     * strings, hashed and compared by the string they point to; a
+     * lookup with a pointer to the argument does not copy it.
+     */
+    struct deref_hash {
+        size_t operator()( const std::string* str ) const {
+            return std::hash< std::string >()( *str );
+        }
+    };
+
+    struct deref_equal {
+        bool operator()( const std::string* lhs, const std::string* rhs ) const {
+            return *lhs == *rhs;
+        }
+    };
+
+    using intern_cache = std::unordered_set< const std::string*, deref_hash, deref_equal >;
+
+    const std::string* intern_shared( const std::string& str ) {
+        /*
+         * Allocated and never destroyed, the interned strings are
+         * referenced by objects which may outlive static destruction.
+         */
+        static auto* table = new std::unordered_set< std::string >();
+        static auto* lock = new std::mutex();
+
+        std::lock_guard< std::mutex > guard( *lock );
+        return std::addressof( *table->insert( str ).first );
+    }
+
+}
+
+    const std::string& intern( const std::string& str ) {
+        thread_local intern_cache cache;
+
+        const auto cached = cache.find( &str );
+        if( cached != cache.end() ) return **cached;
+
+        const auto* interned = intern_shared( str );
+        cache.insert( interned );
+        return *interned;
+    }
+
+}
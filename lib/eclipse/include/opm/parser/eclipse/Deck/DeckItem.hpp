@@ -26,6 +26,7 @@
 #include <ostream>
 
 #include <opm/parser/eclipse/Units/Dimension.hpp>
+#include <opm/parser/eclipse/Utility/Intern.hpp>
 #include <opm/parser/eclipse/Utility/Typetools.hpp>
 
 namespace Opm {
@@ -80,6 +81,17 @@ namespace Opm {
         void push_backDimension( const Dimension& /* activeDimension */,
                                  const Dimension& /* defaultDimension */);
 
+        /*
+          Convert the data to SI units with the dimensions pushed so far.
+          The parser does this for every item when the units are applied
+          to the deck, after which getSIDoubleData() is a pure read and
+          safe to call from several threads. Items assembled by hand are
+          converted on the first call to getSIDoubleData() instead, or
+          by calling convertToSI() up front; an item which is already
+          converted is left alone.
+        */
+        void convertToSI() const;
+
         type_tag getType() const;
 
         void write(DeckOutput& writer) const;
@@ -106,6 +118,8 @@ namespace Opm {
         bool operator==(const DeckItem& other) const;
         bool operator!=(const DeckItem& other) const;
 
+        friend class DeckCache;
+
     private:
         std::vector< double > dval;
         std::vector< int > ival;
@@ -113,16 +127,23 @@ namespace Opm {
 
         type_tag type = type_tag::unknown;
 
-        std::string item_name;
+        /* interned, shared by all the items with the same name */
+        const std::string* item_name = &intern( "" );
         std::vector< bool > defaulted;
         std::vector< Dimension > dimensions;
+        /*
+          The SI data is empty when every dimension is the identity, in
+          which case the raw data is returned.
+        */
         mutable std::vector< double > SIdata;
+        mutable bool SIconverted = false;
 
         template< typename T > std::vector< T >& value_ref();
         template< typename T > const std::vector< T >& value_ref() const;
         template< typename T > void push( T );
         template< typename T > void push( T, size_t );
         template< typename T > void push_default( T );
+        void convert() const;
         template< typename T > void write_vector(DeckOutput& writer, const std::vector<T>& data) const;
     };
 }
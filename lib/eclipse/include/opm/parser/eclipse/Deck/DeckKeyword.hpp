@@ -25,6 +25,7 @@
 #include <memory>
 
 #include <opm/parser/eclipse/Deck/DeckRecord.hpp>
+#include <opm/parser/eclipse/Utility/Intern.hpp>
 
 namespace Opm {
     class ParserKeyword;
@@ -40,6 +41,7 @@ namespace Opm {
         const std::string& name() const;
         void setFixedSize();
         void setLocation(const std::string& fileName, int lineNumber);
+        void setLocation(std::shared_ptr< const std::string > fileName, int lineNumber);
         const std::string& getFileName() const;
         int getLineNumber() const;
 
@@ -63,7 +65,7 @@ namespace Opm {
 
         template <class Keyword>
         bool isKeyword() const {
-            if (Keyword::keywordName == m_keywordName)
+            if (Keyword::keywordName == *m_keywordName)
                 return true;
             else
                 return false;
@@ -77,9 +79,12 @@ namespace Opm {
         bool operator!=(const DeckKeyword& other) const;
 
         friend std::ostream& operator<<(std::ostream& os, const DeckKeyword& keyword);
+        friend class DeckCache;
     private:
-        std::string m_keywordName;
-        std::string m_fileName;
+        /* interned, shared by all the keywords with the same name */
+        const std::string* m_keywordName;
+        /* shared by all the keywords of the file */
+        std::shared_ptr< const std::string > m_fileName;
         int m_lineNumber;
 
         std::vector< DeckRecord > m_recordList;
@@ -49,9 +49,12 @@ namespace Opm {
     public:
 
         Eclipse3DProperties() = default;
+
+        /// The pore volume is computed on up to threads threads.
         Eclipse3DProperties(const Deck& deck,
                             const TableManager& tableManager,
-                            const EclipseGrid& eclipseGrid);
+                            const EclipseGrid& eclipseGrid,
+                            size_t threads = 1);
 
 
         std::vector< int > getRegions( const std::string& keyword ) const;
@@ -68,8 +71,20 @@ namespace Opm {
         bool supportsGridProperty(const std::string& keyword) const;
         MessageContainer getMessageContainer();
 
+        /*
+          Store all the properties for the active cells of the grid
+          only, see GridProperty::compress(); the ACTNUM of the grid
+          must be final. This is opt-in, since getData() of a
+          compressed property throws. The region keywords and
+          TransMult::applyMULT() work with both storage modes, the box
+          keywords (EQUALS, MULTIPLY, ...) do not.
+        */
+        void compress(const EclipseGrid& eclipseGrid);
+
     private:
+        std::string getRegionName(const DeckItem& regionItem) const;
         const GridProperty<int>& getRegion(const DeckItem& regionItem) const;
+        std::vector< std::vector< const DeckRecord* > > groupRegionRecords(const DeckKeyword& deckKeyword) const;
         void processGridProperties(const Deck& deck,
                                    const EclipseGrid& eclipseGrid);
 
@@ -98,6 +113,7 @@ namespace Opm {
         UnitSystem             m_deckUnitSystem;
         GridProperties<int>    m_intGridProperties;
         GridProperties<double> m_doubleGridProperties;
+        size_t                 m_threads = 1;
     };
 }
 
@@ -65,7 +65,18 @@ namespace Opm {
             AllProperties = IntProperties | DoubleProperties
         };
 
-        EclipseState(const Deck& deck , ParseContext parseContext = ParseContext());
+        /*
+          With threads > 1 the components which do not depend on the grid
+          (tables, runspec, config, NNC and faults) are built concurrently
+          with the grid and the grid properties, and the grid properties
+          are computed with up to threads threads. The components then
+          read the deck concurrently, which requires every double item
+          to be converted to SI units; the parser does that, and any
+          item still unconverted, e.g. in a deck built by hand, is
+          converted on the calling thread before the components are
+          started. The deck must not be modified during construction.
+        */
+        EclipseState(const Deck& deck , ParseContext parseContext = ParseContext(), size_t threads = 1);
 
         const ParseContext& getParseContext() const;
         const IOConfig& getIOConfig() const;
@@ -87,6 +98,15 @@ namespace Opm {
         bool hasInputNNC() const;
 
         const Eclipse3DProperties& get3DProperties() const;
+
+        /*
+          Opt-in: store the grid properties for the active cells only;
+          see Eclipse3DProperties::compress(). The grid section of the
+          deck is fully processed by the constructor, and
+          applyModifierDeck() does not read the grid properties, so
+          this can be called any time after the construction.
+        */
+        void compressGridProperties();
         const TableManager& getTableManager() const;
         const EclipseConfig& getEclipseConfig() const;
         const EclipseConfig& cfg() const;
@@ -107,22 +127,27 @@ namespace Opm {
         const Runspec& runspec() const;
 
     private:
+        struct Components;
+        EclipseState(const Deck& deck, ParseContext parseContext, size_t threads, Components&& components);
+
         void initIOConfigPostSchedule(const Deck& deck);
         void initTransMult();
-        void initFaults(const Deck& deck);
-
-        void setMULTFLT(const Opm::Section& section);
+        void initFaults(FaultCollection faults);
 
         void complainAboutAmbiguousKeyword(const Deck& deck,
                                            const std::string& keywordName);
 
+        /*
+          The grid is declared before the grid independent components, so
+          that it is built while they are, see the constructor.
+        */
         ParseContext m_parseContext;
+        UnitSystem m_deckUnitSystem;
+        EclipseGrid m_inputGrid;
         const TableManager m_tables;
         Runspec m_runspec;
         EclipseConfig m_eclipseConfig;
-        UnitSystem m_deckUnitSystem;
         NNC m_inputNnc;
-        EclipseGrid m_inputGrid;
         Eclipse3DProperties m_eclipseProperties;
         const SimulationConfig m_simulationConfig;
         TransMult m_transMult;
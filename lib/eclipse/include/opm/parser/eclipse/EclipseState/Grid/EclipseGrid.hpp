@@ -33,7 +33,9 @@
 #include <ert/util/ert_unique_ptr.hpp>
 
 #include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace Opm {
@@ -170,6 +172,30 @@ namespace Opm {
         size_t exportZCORN( std::vector<double>& zcorn) const;
 
 
+        /*
+          The volume, center depth and thickness of all the cells in
+          global index order, computed with one pass over the grid
+          which is split over up to threads threads.
+        */
+        void exportCellGeometry( std::vector<double>& volume,
+                                 std::vector<double>& depth,
+                                 std::vector<double>& thickness,
+                                 size_t threads = 1 ) const;
+
+        /*
+          The geometry of all the cells as contiguous arrays in global
+          index order; the centers are returned as the three arrays x,
+          y and z and the dimensions as dx, dy and thickness. Every
+          quantity is computed, with up to threads threads, the first
+          time it is asked for and is then kept for the lifetime of the
+          grid; the single cell getters above do not fill these caches.
+          The arrays can be read concurrently.
+        */
+        const std::array< std::vector<double>, 3 >& getCellCenters(size_t threads = 1) const;
+        const std::vector<double>& getCellDepths(size_t threads = 1) const;
+        const std::vector<double>& getCellVolumes(size_t threads = 1) const;
+        const std::array< std::vector<double>, 3 >& getCellDimensions(size_t threads = 1) const;
+
         void exportMAPAXES( std::vector<double>& mapaxes) const;
         void exportCOORD( std::vector<double>& coord) const;
         void exportACTNUM( std::vector<int>& actnum) const;
@@ -186,9 +212,55 @@ namespace Opm {
         Value<double> m_pinch;
         PinchMode::ModeEnum m_pinchoutMode;
         PinchMode::ModeEnum m_multzMode;
-        mutable std::vector< int > activeMap;
         bool m_circle = false;
 
+        /*
+          The internal class lazy holds a value which is computed on
+          first use; concurrent first readers will wait for the one
+          computing it. A copy shares the value if it has been
+          computed; the constructors which create a grid from a src
+          grid with new zcorn or actnum start out with empty caches.
+        */
+        template< typename T >
+        class lazy {
+        public:
+            lazy() = default;
+            lazy(const lazy& src) {
+                if( src.ready.load( std::memory_order_acquire ) ) {
+                    this->value = src.value;
+                    this->ready = true;
+                }
+            }
+
+            template< typename F >
+            const T& get(F fill) const {
+                if( !this->ready.load( std::memory_order_acquire ) ) {
+                    std::lock_guard< std::mutex > lock( this->mutex );
+                    if( !this->ready.load( std::memory_order_relaxed ) ) {
+                        fill( this->value );
+                        this->ready.store( true, std::memory_order_release );
+                    }
+                }
+                return this->value;
+            }
+
+            void reset() {
+                this->value = T();
+                this->ready = false;
+            }
+
+        private:
+            mutable std::mutex mutex;
+            mutable std::atomic< bool > ready{ false };
+            mutable T value;
+        };
+
+        lazy< std::vector< int > > activeMap;
+        lazy< std::array< std::vector< double >, 3 > > cellCenters;
+        lazy< std::vector< double > > cellDepths;
+        lazy< std::vector< double > > cellVolumes;
+        lazy< std::array< std::vector< double >, 3 > > cellDimensions;
+
         /*
           The internal class grid_ptr is a a std::unique_ptr with
           special copy semantics. The purpose of implementing this is
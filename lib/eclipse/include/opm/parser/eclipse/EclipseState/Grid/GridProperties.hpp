@@ -24,6 +24,7 @@
 #include <vector>
 #include <unordered_map>
 #include <map>
+#include <memory>
 
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/Deck/Section.hpp>
@@ -116,6 +117,14 @@ namespace Opm {
         const MessageContainer& getMessageContainer() const;
         MessageContainer& getMessageContainer();
 
+        /*
+          Compress the properties to the active cells, both the
+          existing ones and those auto created later; see
+          GridProperty::compress().
+        */
+        void compress( std::shared_ptr< const std::vector< int > > activeIndex );
+        bool isCompressed() const;
+
 
         template <class Keyword>
         bool hasKeyword() const {
@@ -147,10 +156,23 @@ namespace Opm {
         void handleCOPYRecord( const DeckRecord& record, BoxManager& boxManager);
         void handleEQUALSRecord( const DeckRecord& record, BoxManager& boxManager);
 
-        void handleEQUALREGRecord( const DeckRecord& record, const GridProperty<int>& regionProperty );
-        void handleADDREGRecord( const DeckRecord& record, const GridProperty<int>& regionProperty );
-        void handleMULTIREGRecord( const DeckRecord& record, const GridProperty<int>& regionProperty );
-        void handleCOPYREGRecord( const DeckRecord& record, const GridProperty<int>& regionProperty );
+        /*
+          The region keywords are applied a group of records at a time:
+          all the records must work on the same arrays, and are applied
+          in a single pass over the region array, split over up to
+          threads threads. The records are first compiled into a table
+          of what to do with the cells of each region value: a later
+          record overrides the earlier ones for EQUALREG, while the
+          shifts and factors of ADDREG and MULTIREG are kept as a list
+          and applied to a cell in record order, giving the same result
+          as applying the records one at a time. The records must not
+          modify the region array itself.
+        */
+        typedef std::vector< const DeckRecord* > RecordGroup;
+        void handleEQUALREGRecords( const RecordGroup& records, const GridProperty<int>& regionProperty, size_t threads = 1 );
+        void handleADDREGRecords( const RecordGroup& records, const GridProperty<int>& regionProperty, size_t threads = 1 );
+        void handleMULTIREGRecords( const RecordGroup& records, const GridProperty<int>& regionProperty, size_t threads = 1 );
+        void handleCOPYREGRecords( const RecordGroup& records, const GridProperty<int>& regionProperty, size_t threads = 1 );
         void handleOPERATERecord( const DeckRecord& record , BoxManager& boxManager);
         /*
           Iterators over initialized properties. The overloaded
@@ -204,6 +226,7 @@ namespace Opm {
         mutable std::unordered_map<std::string, SupportedKeywordInfo> m_supportedKeywords;
         mutable storage m_properties;
         mutable std::set<std::string> m_autoGeneratedProperties;
+        std::shared_ptr< const std::vector< int > > m_activeIndex;
     };
 
 }
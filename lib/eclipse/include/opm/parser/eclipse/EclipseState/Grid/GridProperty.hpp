@@ -20,6 +20,7 @@
 #define ECLIPSE_GRIDPROPERTY_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -180,18 +181,48 @@ public:
      std::vector<size_t>  cellsEqual(T value, const EclipseGrid& grid, bool active = true)  const;
 
     /*
-      Will return a std::vector<T> of the data in the active cells.
+      Will return a std::vector<T> of the data in the active cells. This
+      is always a copy; the values of a compressed property can be read
+      in place with getCompressedData().
     */
      std::vector<T> compressedCopy( const EclipseGrid& grid) const;
 
+    /*
+      Opt-in storage of the active cells only, to be used when ACTNUM
+      is final. The activeIndex vector maps global index -> active
+      index, with -1 for inactive cells, and is shared by all the
+      properties of a grid; the post processor is run before the
+      values of the inactive cells are dropped.
+
+      The values of a compressed property can still be read with
+      iget(), where an inactive cell reads as zero, but getData() and
+      all the methods modifying more than a single cell will throw
+      std::logic_error.
+    */
+    void compress( std::shared_ptr< const std::vector< int > > activeIndex );
+    bool isCompressed() const;
+
+    /*
+      The values of the active cells of a compressed property, and the
+      global index -> active index map they are stored by; this is the
+      storage itself, i.e. compressedCopy() without the copy. Code
+      working on whole arrays should use these when isCompressed() is
+      true, and getData() otherwise.
+    */
+    const std::vector<T>& getCompressedData() const;
+    std::vector<T>& getCompressedData();
+    const std::vector<int>& getActiveIndex() const;
+
 private:
     const DeckItem& getDeckItem( const DeckKeyword& );
+    void assertUncompressed( const std::string& method ) const;
     void setDataPoint(size_t sourceIdx, size_t targetIdx, const DeckItem& deckItem);
 
     size_t m_nx, m_ny, m_nz;
     SupportedKeywordInfo m_kwInfo;
     std::vector<T> m_data;
     bool m_hasRunPostProcessor = false;
+    std::shared_ptr< const std::vector< int > > m_activeIndex;
 };
 
 // initialize the TEMPI grid property using the temperature vs depth
@@ -21,6 +21,9 @@
 #ifndef OPM_PARSER_MULTREGTSCANNER_HPP
 #define OPM_PARSER_MULTREGTSCANNER_HPP
 
+#include <map>
+#include <vector>
+
 #include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/FaceDir.hpp>
 #include <opm/parser/eclipse/EclipseState/Util/Value.hpp>
@@ -32,6 +35,8 @@ namespace Opm {
 
     class DeckRecord;
     class DeckKeyword;
+    class GridDims;
+    class NNC;
 
     namespace MULTREGT {
 
@@ -74,11 +79,51 @@ namespace Opm {
                         const std::vector< const DeckKeyword* >& keywords);
         double getRegionMultiplier(size_t globalCellIdx1, size_t globalCellIdx2, FaceDir::DirEnum faceDir) const;
 
+        /*
+          The multipliers of the faces between every cell and its
+          neighbour in the positive faceDir direction, which must be
+          XPlus, YPlus or ZPlus, by the global index of the cell. Faces
+          on the boundary of the grid get 1. The cells are split between
+          up to threads threads.
+        */
+        std::vector<double> getRegionMultipliers(const GridDims& dims, FaceDir::DirEnum faceDir, size_t threads = 1) const;
+
+        /*
+          The multipliers of the non-neighbouring connections, in the
+          order of nnc.nncdata(). A connection between cells in
+          different I columns is an X face, otherwise one between cells
+          in different J rows is a Y face, otherwise it is a Z face.
+        */
+        std::vector<double> getRegionMultipliers(const GridDims& dims, const NNC& nnc) const;
+
     private:
+        /*
+          The records of one region keyword, as a flat table of
+          positions in m_records (or -1) indexed by pairs of region
+          values. The region values used by the records are kept
+          sorted in regions, and numbered by their position there, so
+          the table has regions.size()^2 entries however large the
+          region values are.
+        */
+        struct RegionTable {
+            std::string keyword;
+            std::vector< int > regions;
+            std::vector< int > records;
+
+            int index(int region) const;
+            int at(int region1, int region2) const;
+        };
+
         void addKeyword( const DeckKeyword& deckKeyword, const std::string& defaultRegion);
         void assertKeywordSupported(const DeckKeyword& deckKeyword, const std::string& defaultRegion);
+        std::vector< const GridProperty< int >* > regionData() const;
+        double getRegionMultiplier(const std::vector< const GridProperty< int >* >& regions,
+                                   size_t nx, size_t ny,
+                                   size_t globalCellIdx1, size_t globalCellIdx2,
+                                   FaceDir::DirEnum faceDir) const;
+
         std::vector< MULTREGTRecord > m_records;
-        std::map<std::string , MULTREGTSearchMap> m_searchMap;
+        std::vector< RegionTable > m_regionTables;
         const Eclipse3DProperties& m_e3DProps;
     };
 
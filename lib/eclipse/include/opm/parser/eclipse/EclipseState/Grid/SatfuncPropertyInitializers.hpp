@@ -197,6 +197,20 @@ namespace Opm {
                                       const TableManager*,
                                       const EclipseGrid*,
                                       GridProperties<int>*);
+
+    /*
+      Evaluate several endpoint scaling keywords, e.g. { "SWL", "ISWL",
+      "KRW" }, in one pass over the grid with up to threads threads. The
+      region properties, cell depths and ENPTVD/IMPTVD depth brackets are
+      shared by the keywords. The arrays are returned in the order of the
+      keywords, and are equal to those of the corresponding *Endpoint()
+      functions; an unknown keyword throws std::invalid_argument.
+    */
+    std::vector<std::vector<double>> endpointScaling(const std::vector<std::string>& keywords,
+                                                     const TableManager*,
+                                                     const EclipseGrid*,
+                                                     const GridProperties<int>*,
+                                                     size_t threads = 1);
 }
 
 #endif // ECLIPSE_SATFUNCPROPERTY_INITIALIZERS_HPP
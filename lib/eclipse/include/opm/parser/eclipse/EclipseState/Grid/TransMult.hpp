@@ -25,14 +25,21 @@
 
       {MULTX , MULTX- , MULTY , MULTY- , MULTZ , MULTZ-, MULTFLT , MULTREGT}
 
+   A face direction only gets a dense array of multipliers when one of
+   the MULTX style keywords is applied to it; the MULTFLT multipliers
+   of the directions without one are stored as a sorted list of
+   (global index, multiplier) pairs, since the faults usually only
+   cover a thin sheet of cells. The MULTREGT multipliers are computed
+   from the region properties when asked for.
 */
 #ifndef OPM_PARSER_TRANSMULT_HPP
 #define OPM_PARSER_TRANSMULT_HPP
 
 
+#include <array>
 #include <cstddef>
-#include <map>
-#include <memory>
+#include <utility>
+#include <vector>
 
 #include <opm/parser/eclipse/EclipseState/Grid/FaceDir.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/MULTREGTScanner.hpp>
@@ -43,6 +50,7 @@ namespace Opm {
     class FaultCollection;
     class Eclipse3DProperties;
     class DeckKeyword;
+    class NNC;
 
     class TransMult {
 
@@ -51,21 +59,45 @@ namespace Opm {
         double getMultiplier(size_t globalIndex, FaceDir::DirEnum faceDir) const;
         double getMultiplier(size_t i , size_t j , size_t k, FaceDir::DirEnum faceDir) const;
         double getRegionMultiplier( size_t globalCellIndex1, size_t globalCellIndex2, FaceDir::DirEnum faceDir) const;
+
+        /// The MULTREGT multipliers of the faces between every cell and its neighbour in the
+        /// positive faceDir direction (XPlus, YPlus or ZPlus), by global cell index. This is
+        /// the same as getRegionMultiplier( g, neighbour( g ), faceDir ) for every cell g, and 1
+        /// on the boundary of the grid, computed on up to threads threads.
+        std::vector<double> getRegionMultipliers( FaceDir::DirEnum faceDir, size_t threads = 1 ) const;
+
+        /// The MULTREGT multipliers of the non-neighbouring connections, in the order of
+        /// nnc.nncdata().
+        std::vector<double> getRegionMultipliers( const NNC& nnc ) const;
+
+        /// The combined multiplier of the connection between every cell and its neighbour
+        /// in the positive faceDir direction (XPlus, YPlus or ZPlus), by global cell index:
+        /// getMultiplier( g, faceDir ) * getMultiplier( neighbour( g ), opposite faceDir ) *
+        /// getRegionMultiplier( g, neighbour( g ), faceDir ), and 1 on the boundary of the
+        /// grid. Computed in one pass over the stored multipliers.
+        std::vector<double> getConnectionMultipliers( FaceDir::DirEnum faceDir, size_t threads = 1 ) const;
         void applyMULT(const GridProperty<double>& srcMultProp, FaceDir::DirEnum faceDir);
         void applyMULTFLT(const FaultCollection& faults);
         void applyMULTFLT(const Fault& fault);
 
     private:
+        typedef std::vector< std::pair< size_t, double > > FaceList;
+
         size_t getGlobalIndex(size_t i , size_t j , size_t k) const;
         void assertIJK(size_t i , size_t j , size_t k) const;
         double getMultiplier__(size_t globalIndex , FaceDir::DirEnum faceDir) const;
-        void insertNewProperty(FaceDir::DirEnum faceDir);
-        bool hasDirectionProperty(FaceDir::DirEnum faceDir) const;
-        GridProperty<double>& getDirectionProperty(FaceDir::DirEnum faceDir);
+        std::vector<double>& getDenseMultipliers(FaceDir::DirEnum faceDir);
+        void collectMULTFLT(const Fault& fault, std::array< FaceList, 6 >& faces);
+        void mergeMULTFLT(std::array< FaceList, 6 >& faces);
 
         size_t m_nx , m_ny , m_nz;
-        std::map<FaceDir::DirEnum , GridProperty<double> > m_trans;
-        std::map<FaceDir::DirEnum , std::string> m_names;
+
+        /*
+          Indexed by the position of the FaceDir bit; for every
+          direction at most one of m_dense and m_sparse is non empty.
+        */
+        std::array< std::vector<double>, 6 > m_dense;
+        std::array< FaceList, 6 > m_sparse;
         MULTREGTScanner m_multregtScanner;
     };
 
@@ -62,6 +62,8 @@ namespace Opm {
 
     private:
         std::vector< Completion > m_completions;
+        /* the number of completions which are not SHUT */
+        size_t m_numOpen = 0;
         size_t findClosestCompletion(int oi, int oj, double oz, size_t start_pos);
     };
 }
@@ -21,10 +21,13 @@
 #ifndef DYNAMICSTATE_HPP_
 #define DYNAMICSTATE_HPP_
 
+#include <memory>
 #include <stdexcept>
 #include <vector>
 #include <algorithm>
 
+#include <boost/iterator/indirect_iterator.hpp>
+
 #include <opm/parser/eclipse/EclipseState/Schedule/TimeMap.hpp>
 
 
@@ -49,6 +52,12 @@ namespace Opm {
        The update() method returns true if the updated value is
        different from the current value, this implies that the
        class<T> must support operator!=
+
+       Internally the state is stored run-length encoded: one value
+       for every timestep where the value changes, and lookup is a
+       binary search over these change points. The values are
+       reference counted and shared between copies of a DynamicState,
+       and only cloned when modified through begin()/end().
     */
 
 
@@ -57,23 +66,31 @@ template< class T >
 class DynamicState {
 
     public:
-        typedef typename std::vector< T >::iterator iterator;
+        typedef boost::indirect_iterator<
+            typename std::vector< std::shared_ptr< T > >::iterator
+        > iterator;
 
         DynamicState( const TimeMap& timeMap, T initial ) :
-            m_data( timeMap.size(), initial ),
+            m_size( timeMap.size() ),
+            m_steps( 1, 0 ),
+            m_values( 1, std::make_shared< T >( std::move( initial ) ) ),
             initial_range( timeMap.size() )
         {}
 
         void globalReset( T value ) {
-            this->m_data.assign( this->m_data.size(), value );
+            this->m_steps.assign( 1, 0 );
+            this->m_values.assign( 1, std::make_shared< T >( std::move( value ) ) );
         }
 
         const T& back() const {
-            return m_data.back();
+            return *this->m_values.back();
         }
 
         const T& at( size_t index ) const {
-            return this->m_data.at( index );
+            if( index >= this->m_size )
+                throw std::out_of_range("Invalid index for DynamicState::at()");
+
+            return *this->m_values[ this->run( index ) ];
         }
 
         const T& operator[](size_t index) const {
@@ -85,7 +102,8 @@ class DynamicState {
         }
 
         void updateInitial( T initial ) {
-            std::fill_n( this->m_data.begin(), this->initial_range, initial );
+            this->assign( 0, this->initial_range,
+                          std::make_shared< T >( std::move( initial ) ) );
         }
 
         /**
@@ -93,53 +111,114 @@ class DynamicState {
            return true, otherwise it will return false.
         */
         bool update( size_t index, T value ) {
-            if( this->initial_range == this->m_data.size() )
+            if( this->initial_range == this->m_size )
                 this->initial_range = index;
 
-            const bool change = (value != this->m_data.at( index ));
+            const bool change = (value != this->at( index ));
 
             if( !change ) return false;
 
-            std::fill( this->m_data.begin() + index,
-                       this->m_data.end(),
-                       value );
+            this->assign( index, this->m_size,
+                          std::make_shared< T >( std::move( value ) ) );
 
             return true;
         }
 
         void update_elm( size_t index, const T& value ) {
-            if (this->m_data.size() <= index)
+            if (this->m_size <= index)
                 throw std::out_of_range("Invalid index for update_elm()");
 
-            this->m_data[index] = value;
+            this->assign( index, index + 1, std::make_shared< T >( value ) );
         }
 
         /// Will return the index of the first occurence of @value, or
         /// -1 if @value is not found.
         int find(const T& value) const {
-            auto iter = std::find( m_data.begin() , m_data.end() , value);
-            if( iter == this->m_data.end() ) return -1;
+            for( size_t i = 0; i < this->m_values.size(); ++i ) {
+                if( *this->m_values[ i ] == value )
+                    return this->m_steps[ i ];
+            }
 
-            return std::distance( m_data.begin() , iter );
+            return -1;
         }
 
 
-
+        /*
+         * Iterate over the distinct values, i.e. once for every change
+         * point rather than once for every timestep. Modifying a value
+         * changes it for all the timesteps it applies to.
+         */
         iterator begin() {
-            return this->m_data.begin();
+            for( auto& value : this->m_values ) {
+                if( value.use_count() > 1 )
+                    value = std::make_shared< T >( *value );
+            }
+
+            return iterator( this->m_values.begin() );
         }
 
 
         iterator end() {
-            return this->m_data.end();
+            return iterator( this->m_values.end() );
         }
 
     private:
-        std::vector< T > m_data;
+        /* the position of the change point in effect at timestep index */
+        size_t run( size_t index ) const {
+            const auto it = std::upper_bound( this->m_steps.begin(),
+                                              this->m_steps.end(),
+                                              index );
+            return std::distance( this->m_steps.begin(), it ) - 1;
+        }
+
+        /* set the timesteps [first, last) to value */
+        void assign( size_t first, size_t last, std::shared_ptr< T > value ) {
+            if( first >= last ) return;
+
+            const bool tail = last < this->m_size;
+            std::shared_ptr< T > next;
+            if( tail ) next = this->m_values[ this->run( last ) ];
+
+            const auto lo = std::distance( this->m_steps.begin(),
+                    std::lower_bound( this->m_steps.begin(), this->m_steps.end(), first ) );
+            const auto hi = std::distance( this->m_steps.begin(),
+                    std::upper_bound( this->m_steps.begin(), this->m_steps.end(), last ) );
+
+            this->m_steps.erase( this->m_steps.begin() + lo, this->m_steps.begin() + hi );
+            this->m_values.erase( this->m_values.begin() + lo, this->m_values.begin() + hi );
+
+            if( tail ) {
+                this->m_steps.insert( this->m_steps.begin() + lo, last );
+                this->m_values.insert( this->m_values.begin() + lo, std::move( next ) );
+            }
+
+            this->m_steps.insert( this->m_steps.begin() + lo, first );
+            this->m_values.insert( this->m_values.begin() + lo, std::move( value ) );
+
+            if( tail ) this->merge( lo + 2 );
+            this->merge( lo + 1 );
+            this->merge( lo );
+        }
+
+        /*
+         * drop the change point at pos if it shares the value of the
+         * previous one. Values are not compared, since operator!= of T
+         * need not compare all of T.
+         */
+        void merge( size_t pos ) {
+            if( pos == 0 || pos >= this->m_steps.size() ) return;
+            if( this->m_values[ pos - 1 ] != this->m_values[ pos ] ) return;
+
+            this->m_steps.erase( this->m_steps.begin() + pos );
+            this->m_values.erase( this->m_values.begin() + pos );
+        }
+
+        size_t m_size;
+        std::vector< size_t > m_steps;
+        std::vector< std::shared_ptr< T > > m_values;
         size_t initial_range;
 };
 
 }
 
 #endif
-
@@ -20,6 +20,7 @@
 #ifndef GROUPTREE_HPP
 #define GROUPTREE_HPP
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -33,6 +34,13 @@ class GroupTree {
         const std::string& parent( const std::string& name ) const;
         std::vector< std::string > children( const std::string& parent ) const;
 
+        /*
+          The children of all the nodes with children, keyed by parent
+          and in the same order as children( parent ); this is one pass
+          over the tree instead of one pass per node.
+        */
+        std::map< std::string, std::vector< std::string > > children() const;
+
         bool operator==( const GroupTree& ) const;
         bool operator!=( const GroupTree& ) const;
 
@@ -21,6 +21,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 
 #include <boost/date_time/posix_time/posix_time_types.hpp>
 
@@ -91,7 +92,9 @@ namespace Opm
              getWells("FIELD",t);
 
           is an inefficient way to get all the wells defined at time
-          't'.
+          't'. The getWellsMatching() method returns the wells matching
+          a pattern with a trailing '*', or the single well with the
+          given name, in the order the wells were defined.
         */
         std::vector< const Well* > getWells(const std::string& group, size_t timeStep) const;
         std::vector< const Well* > getWellsMatching( const std::string& ) const;
@@ -120,17 +123,32 @@ namespace Opm
     private:
         TimeMap m_timeMap;
         OrderedMap< Well > m_wells;
+        /*
+          The well names sorted, mapped to the insertion order of the
+          wells, so that a pattern only has to be tested against the
+          wells which share its literal prefix.
+        */
+        std::map< std::string, size_t > m_wellIndex;
         std::map<std::string, Group > m_groups;
         DynamicState< GroupTree > m_rootGroupTree;
         DynamicState< OilVaporizationProperties > m_oilvaporizationproperties;
         Events m_events;
-        DynamicVector< Deck > m_modifierDeck;
+        /*
+          The supported geo modifiers only appear at a few report
+          steps, so the minidecks are only stored for those steps.
+        */
+        std::map< size_t, Deck > m_modifierDeck;
         Tuning m_tuning;
         MessageLimits m_messageLimits;
         Phases m_phases;
 
         MessageContainer m_messages;
         WellProducer::ControlModeEnum m_controlModeWHISTCTL;
+        /*
+          The wells whose completions or status have changed since the
+          last check for wells with all completions shut.
+        */
+        std::set< std::string > m_changedWells;
 
         std::vector< Well* > getWells(const std::string& wellNamePattern);
         void updateWellStatus( Well& well, size_t reportStep , WellCommon::StatusEnum status);
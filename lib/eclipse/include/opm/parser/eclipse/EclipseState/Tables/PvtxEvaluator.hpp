@@ -0,0 +1,99 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OPM_PARSER_PVTX_EVALUATOR_HPP
+#define OPM_PARSER_PVTX_EVALUATOR_HPP
+
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+    class PvtxTable;
+
+    /*
+      A compiled form of a PVTO or PVTG table for evaluation in a
+      property loop. The undersaturated tables are flattened into
+      contiguous arrays and the inverse interval widths of the outer
+      column and of every inner argument column are precomputed, so an
+      evaluation is one binary search in the outer column and one in
+      each of the two undersaturated tables involved.
+
+      The results are those of PvtxTable::evaluate(): arguments outside
+      a table are clamped to its end points, where the derivative is
+      zero. Value columns are addressed by a handle from column(), e.g.
+      column("BO") for PVTO, to avoid name lookups.
+
+      The evaluator is immutable once constructed, and can be used from
+      any number of threads at the same time.
+    */
+    class PvtxEvaluator {
+    public:
+        explicit PvtxEvaluator( const PvtxTable& table );
+
+        size_t column( const std::string& name ) const;
+
+        double evaluate( size_t column, double outerArg, double innerArg ) const;
+        double evaluate( size_t column, double outerArg, double innerArg,
+                         double& dOuter, double& dInner ) const;
+
+        /*
+          Evaluate at the (outerArgs[i], innerArgs[i]) pairs. The
+          derivatives are only computed when the corresponding pointer
+          is not null.
+        */
+        std::vector< double > evaluate( size_t column,
+                                        const std::vector< double >& outerArgs,
+                                        const std::vector< double >& innerArgs,
+                                        std::vector< double >* dOuter = nullptr,
+                                        std::vector< double >* dInner = nullptr ) const;
+
+    private:
+        struct Bracket {
+            size_t index;
+            double weight2;
+            double inverseWidth;  /* zero if the argument was clamped */
+        };
+
+        static Bracket find( const double* values, const double* inverseWidth,
+                             size_t size, bool decreasing, double arg );
+
+        double interpolate( size_t table, size_t column, double innerArg, double* dInner ) const;
+        double interpolate( size_t column, double outerArg, double innerArg,
+                            double* dOuter, double* dInner ) const;
+        void assertColumn( size_t column ) const;
+
+        std::vector< std::string > m_columnNames;
+
+        std::vector< double > m_outer;
+        std::vector< double > m_outerInverseWidth;
+
+        /*
+          The inner argument of undersaturated table k is stored in
+          m_inner[ m_offset[k] ... m_offset[k+1] ), and the values of
+          column c at the same positions of m_values[c].
+        */
+        std::vector< size_t > m_offset;
+        std::vector< char > m_decreasing;
+        std::vector< double > m_inner;
+        std::vector< double > m_innerInverseWidth;
+        std::vector< std::vector< double > > m_values;
+    };
+}
+
+#endif
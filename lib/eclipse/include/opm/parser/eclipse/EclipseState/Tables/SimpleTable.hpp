@@ -60,6 +60,16 @@ namespace Opm {
          */
         double evaluate(const std::string& columnName, double xPos) const;
 
+        /*!
+         * \brief Evaluate a column of the table at several positions.
+         *
+         * The argument column is checked once and every position is
+         * bracketed with a binary search; the column is addressed by
+         * index to avoid the name lookup.
+         */
+        std::vector<double> evaluate(size_t columnIndex, const std::vector<double>& xPos) const;
+        std::vector<double> evaluate(const std::string& columnName, const std::vector<double>& xPos) const;
+
         /// throws std::invalid_argument if jf != m_jfunc
         void assertJFuncPressure(const bool jf) const;
 
@@ -53,6 +53,13 @@ namespace Opm {
         */
         TableIndex lookup(double argValue) const;
         double eval( const TableIndex& index) const;
+
+        /*
+           Batch versions of lookup() and eval(); the column is
+           checked once for the whole range of arguments.
+        */
+        std::vector<TableIndex> lookup(const std::vector<double>& argValues) const;
+        std::vector<double> eval( const std::vector<TableIndex>& indices) const;
         void applyDefaults( const TableColumn& argColumn );
         void assertUnitRange() const;
         TableColumn& operator= (const TableColumn& other);
@@ -64,12 +71,23 @@ namespace Opm {
         void assertUpdate(size_t index, double value) const;
         void assertPrevious(size_t index , double value) const;
         void assertNext(size_t index , double value) const;
+        void assertLookup() const;
+        void updateBounds();
+        TableIndex bracket(double argValue) const;
 
         ColumnSchema m_schema;
         std::string m_name;
         std::vector<double> m_values;
         std::vector<bool> m_default;
         size_t m_defaultCount;
+
+        /*
+          The position of the smallest and largest value, kept up to
+          date as values are added; only valid when there are no
+          defaulted values.
+        */
+        size_t m_minIndex = 0;
+        size_t m_maxIndex = 0;
     };
 
 
@@ -0,0 +1,178 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PARSER_ECLIPSE_ECLIPSESTATE_TABLES_VFPINTERPOLATOR_HPP_
+#define OPM_PARSER_ECLIPSE_ECLIPSESTATE_TABLES_VFPINTERPOLATOR_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace Opm {
+
+    class VFPInjTable;
+    class VFPProdTable;
+
+/**
+ * Interpolated bottom hole pressure together with its partial
+ * derivatives with respect to the table arguments. The derivatives
+ * with respect to arguments the table does not have are zero.
+ */
+struct VFPEvaluation {
+    double value = 0;
+    double dflo = 0;
+    double dthp = 0;
+    double dwfr = 0;
+    double dgfr = 0;
+    double dalq = 0;
+};
+
+/**
+ * One axis of a VFP table, with the inverse widths of the intervals
+ * precomputed so that locating an argument is a binary search and one
+ * multiplication.
+ */
+class VFPAxis {
+public:
+    struct Bracket {
+        size_t index;        //< Lower point of the interval
+        double factor;       //< Position of the argument in the interval
+        double inverseWidth; //< 1 / length of the interval
+    };
+
+    VFPAxis() = default;
+
+    /**
+     * @param values Strictly increasing sample points of the axis
+     */
+    explicit VFPAxis(const std::vector<double>& values);
+
+    size_t size() const;
+
+    /**
+     * Locates the interval containing the argument. Arguments outside
+     * the axis use the first or last interval, i.e. factor is outside
+     * [0,1] and the table is extrapolated linearly. An axis with a
+     * single point always gives index 0 and factor 0.
+     */
+    Bracket find(double x) const;
+
+private:
+    std::vector<double> m_values;
+    std::vector<double> m_inverseWidth;
+};
+
+
+/**
+ * Multilinear interpolation of a VFPPROD table.
+ *
+ * The table data is copied and reordered to [wfr][gfr][alq][thp][flo],
+ * so that the four values spanning a THP/FLO cell are within two
+ * consecutive rows of the copy. The FLO interpolation is done first,
+ * for all sixteen corner pairs in one branch free loop which the
+ * compiler can vectorise.
+ *
+ * All evaluation methods are const and do not modify any state, so an
+ * interpolator can be shared by any number of threads.
+ */
+class VFPProdInterpolator {
+public:
+    explicit VFPProdInterpolator(const VFPProdTable& table);
+
+    /**
+     * Interpolated bottom hole pressure for one well state.
+     */
+    double bhp(double flo, double thp, double wfr, double gfr, double alq) const;
+
+    /**
+     * Interpolated bottom hole pressure and its derivatives for one
+     * well state.
+     */
+    VFPEvaluation evaluate(double flo, double thp, double wfr, double gfr, double alq) const;
+
+    /**
+     * Batch versions; all the arguments must have the same size, and
+     * element i of the result corresponds to element i of the
+     * arguments.
+     */
+    std::vector<double> bhp(const std::vector<double>& flo,
+                            const std::vector<double>& thp,
+                            const std::vector<double>& wfr,
+                            const std::vector<double>& gfr,
+                            const std::vector<double>& alq) const;
+
+    std::vector<VFPEvaluation> evaluate(const std::vector<double>& flo,
+                                        const std::vector<double>& thp,
+                                        const std::vector<double>& wfr,
+                                        const std::vector<double>& gfr,
+                                        const std::vector<double>& alq) const;
+
+private:
+    double interpolate(double flo, double thp, double wfr, double gfr, double alq,
+                       VFPEvaluation* evaluation) const;
+
+    VFPAxis m_flo;
+    VFPAxis m_thp;
+    VFPAxis m_wfr;
+    VFPAxis m_gfr;
+    VFPAxis m_alq;
+
+    /* Distance to the upper neighbour along each axis, 0 for single point axes. */
+    size_t m_flo_step;
+    size_t m_thp_step;
+    size_t m_alq_step;
+    size_t m_gfr_step;
+    size_t m_wfr_step;
+
+    std::vector<double> m_data;
+};
+
+
+/**
+ * Bilinear interpolation of a VFPINJ table, with the same conventions
+ * as VFPProdInterpolator.
+ */
+class VFPInjInterpolator {
+public:
+    explicit VFPInjInterpolator(const VFPInjTable& table);
+
+    double bhp(double flo, double thp) const;
+    VFPEvaluation evaluate(double flo, double thp) const;
+
+    std::vector<double> bhp(const std::vector<double>& flo,
+                            const std::vector<double>& thp) const;
+
+    std::vector<VFPEvaluation> evaluate(const std::vector<double>& flo,
+                                        const std::vector<double>& thp) const;
+
+private:
+    double interpolate(double flo, double thp, VFPEvaluation* evaluation) const;
+
+    VFPAxis m_flo;
+    VFPAxis m_thp;
+
+    size_t m_flo_step;
+    size_t m_thp_step;
+
+    std::vector<double> m_data;
+};
+
+} //Namespace opm
+
+
+#endif /* OPM_PARSER_ECLIPSE_ECLIPSESTATE_TABLES_VFPINTERPOLATOR_HPP_ */
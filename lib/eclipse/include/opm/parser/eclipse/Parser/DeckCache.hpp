@@ -0,0 +1,98 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_DECK_CACHE_HPP
+#define OPM_DECK_CACHE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+namespace Opm {
+
+    class Deck;
+    class DeckItem;
+    class DeckKeyword;
+    class ParseContext;
+    class Parser;
+    class UnitSystem;
+
+    /*
+     * A binary cache of a parsed and unit converted deck, stored in a
+     * single file. The cache records the root file and every file it
+     * INCLUDEs, and is only used while none of them have changed: the size
+     * and content hash of every file are compared, so a same size rewrite
+     * within the resolution of the modification time is noticed. The
+     * files are read once for this on every load. The cache is also
+     * tied to the keywords of the parser, by the hash of their deck names
+     * and definitions (Parser::definitionHash()), and the actions of the
+     * parse context used to create it.
+     *
+     * The layout of the file is native and 8-byte aligned, and numeric
+     * arrays are stored as plain memory images which are loaded with a
+     * single copy from the mapped file.
+     *
+     * Use it through Parser::parseFile( dataFile, parseContext, cache ).
+     */
+    class DeckCache {
+    public:
+        explicit DeckCache( const std::string& path );
+
+        const std::string& path() const;
+
+        /*
+         * Load the cached deck of dataFile. Returns false if there is no
+         * cache, or if the cache is stale or unreadable.
+         */
+        bool load( const std::string& dataFile,
+                   const Parser&,
+                   const ParseContext&,
+                   Deck& ) const;
+
+        /*
+         * Store the deck parsed from files, the first of which is the root
+         * file. Files which could not be opened are recorded as missing.
+         * Errors when writing the cache are silently ignored.
+         */
+        void store( const Deck&,
+                    const std::vector< boost::filesystem::path >& files,
+                    const Parser&,
+                    const ParseContext& ) const;
+
+        static uint64_t hash( const char* data, size_t size );
+
+    private:
+        class Writer;
+        class Reader;
+
+        static void write( Writer&, const UnitSystem& );
+        static void write( Writer&, const DeckKeyword& );
+        static void write( Writer&, const DeckItem& );
+        static void read( Reader&, UnitSystem& );
+        static DeckKeyword readKeyword( Reader&, std::shared_ptr< const std::string >& fileName );
+        static DeckItem readItem( Reader& );
+
+        std::string m_path;
+    };
+}
+
+#endif
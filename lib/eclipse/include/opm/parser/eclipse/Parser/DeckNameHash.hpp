@@ -0,0 +1,75 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_DECK_NAME_HASH_HPP
+#define OPM_DECK_NAME_HASH_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <opm/parser/eclipse/Utility/Stringview.hpp>
+
+namespace Opm {
+
+    /*
+     * A perfect hash of a fixed set of deck names. Deck names are at most
+     * eight characters, and are hashed as the 64 bit integer holding the
+     * characters of the name, see pack().
+     *
+     * The hash is built with hash and displace: the names are first hashed
+     * into buckets, and every bucket is given the seed of a second hash
+     * which puts all names in the bucket in distinct, free slots. Looking up
+     * a name then costs two hashes and one comparison, and never allocates.
+     *
+     * The table of the built-in keywords is computed by genkw and compiled
+     * into the library as plain arrays.
+     */
+    class DeckNameHash {
+    public:
+        struct table {
+            std::vector< uint32_t > seeds;
+            std::vector< uint64_t > keys;
+        };
+
+        DeckNameHash( const uint32_t* seeds, size_t buckets,
+                      const uint64_t* keys, size_t slots );
+        /* the table is not copied, and must outlive the hash */
+        explicit DeckNameHash( const table& );
+
+        /* the slot of name, or -1 if it is not in the set */
+        int slot( const string_view& name ) const;
+        /* the name in slot, or the empty string if the slot is unused */
+        std::string name( size_t slot ) const;
+        size_t size() const;
+
+        /* the name as an integer, or 0 if it is empty or too long */
+        static uint64_t pack( const string_view& name );
+        static std::string unpack( uint64_t key );
+        static table build( const std::vector< std::string >& names );
+
+    private:
+        const uint32_t* seeds;
+        size_t buckets;
+        const uint64_t* keys;
+        size_t slots;
+    };
+}
+
+#endif
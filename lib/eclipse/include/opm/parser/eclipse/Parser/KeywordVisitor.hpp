@@ -0,0 +1,60 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_KEYWORD_VISITOR_HPP
+#define OPM_KEYWORD_VISITOR_HPP
+
+#include <string>
+
+namespace Opm {
+
+    class DeckKeyword;
+
+    /*
+     * Receives the keywords of a deck one at a time, as they are parsed, see
+     * Parser::parseFile( dataFile, parseContext, visitor ). No Deck is built;
+     * a keyword is freed as soon as visit() returns, unless the visitor
+     * moves it somewhere else.
+     *
+     * Keywords are visited in deck order, fully parsed and unit converted.
+     * The keywords of the RUNSPEC section are held back until the section
+     * ends, since the unit system is only known then.
+     */
+    class KeywordVisitor {
+    public:
+        virtual ~KeywordVisitor() = default;
+
+        /*
+         * Called when a section keyword (RUNSPEC, GRID, EDIT, PROPS, REGIONS,
+         * SOLUTION, SUMMARY, SCHEDULE) is reached. Return false to skip the
+         * whole section, including the section keyword itself.
+         */
+        virtual bool section( const std::string& /* name */ ) { return true; }
+
+        /*
+         * Called for every keyword outside of skipped sections. Return false
+         * to skip the keyword, whose items are then never parsed.
+         */
+        virtual bool keyword( const std::string& /* name */ ) { return true; }
+
+        virtual void visit( DeckKeyword&& keyword ) = 0;
+    };
+}
+
+#endif
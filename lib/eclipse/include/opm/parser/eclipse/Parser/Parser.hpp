@@ -20,14 +20,17 @@
 #ifndef OPM_PARSER_HPP
 #define OPM_PARSER_HPP
 
+#include <atomic>
 #include <iosfwd>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <boost/filesystem.hpp>
 
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/Parser/DeckNameHash.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
 #include <opm/parser/eclipse/Utility/Stringview.hpp>
 
@@ -38,6 +41,9 @@ namespace Json {
 namespace Opm {
 
     class Deck;
+    class DeckCache;
+    class KeywordVisitor;
+    class MessageContainer;
     class ParseContext;
     class RawKeyword;
 
@@ -49,11 +55,34 @@ namespace Opm {
     public:
         explicit Parser(bool addDefault = true);
 
+        /// A built-in keyword, which is only constructed when it is first looked up.
+        struct KeywordFactory {
+            const char* deckNames;  // separated by spaces
+            bool wildcard;          // keywords matching a regular expression are constructed up front
+            std::unique_ptr< const ParserKeyword > (*create)();
+            uint64_t definition;    // ParserKeyword::definitionHash() of the keyword
+        };
+
         static std::string stripComments(const std::string& inputString);
 
         /// The starting point of the parsing process. The supplied file is parsed, and the resulting Deck is returned.
         Deck parseFile(const std::string &dataFile,
                        const ParseContext& = ParseContext()) const;
+        /// Parse the file, with the files it INCLUDEs parsed concurrently on up to threads
+        /// threads. The resulting Deck is identical to the one parsed serially.
+        Deck parseFile(const std::string &dataFile,
+                       const ParseContext& parseContext,
+                       size_t threads) const;
+        /// Parse the file, or load the deck from the cache if the cache is still valid for it.
+        /// A freshly parsed deck is stored in the cache.
+        Deck parseFile(const std::string &dataFile,
+                       const ParseContext& parseContext,
+                       const DeckCache& cache) const;
+        /// Parse the file without building a Deck, handing each keyword to the visitor
+        /// as soon as it is parsed. Returns the messages of the parse.
+        MessageContainer parseFile(const std::string &dataFile,
+                                   const ParseContext& parseContext,
+                                   KeywordVisitor& visitor) const;
         Deck parseString(const std::string &data,
                          const ParseContext& = ParseContext()) const;
         Deck parseStream(std::unique_ptr<std::istream>&& inputStream , const ParseContext& parseContext) const;
@@ -71,6 +100,11 @@ namespace Opm {
         bool isRecognizedKeyword( const string_view& deckKeywordName) const;
         const ParserKeyword* getParserKeywordFromDeckName(const string_view& deckKeywordName) const;
         std::vector<std::string> getAllDeckNames () const;
+        /*
+         * A hash of the deck names and the definitions of all the keywords;
+         * the built-in keywords are not constructed to compute it.
+         */
+        uint64_t definitionHash() const;
 
         void loadKeywords(const Json::JsonObject& jsonKeywords);
         bool loadKeywordFromFile(const boost::filesystem::path& configFile);
@@ -121,9 +155,38 @@ namespace Opm {
         // ParserKeyword object for keywords which match a regular expression
         std::map< string_view, const ParserKeyword* > m_wildCardKeywords;
 
+        // the keywords of the deck names known at build time, by their slot
+        // in the perfect hash, and the number of other deck names in
+        // m_deckParserKeywords. A built-in keyword is only constructed, by
+        // its factory, when it is first looked up, which can happen
+        // concurrently.
+        struct hashed_keyword {
+            std::atomic< const ParserKeyword* > keyword{ nullptr };
+            const KeywordFactory* factory = nullptr;
+        };
+        DeckNameHash m_deckNameHash;
+        std::vector< hashed_keyword > m_hashedKeywords;
+        size_t m_unhashedDeckNames = 0;
+        std::unique_ptr< std::mutex > m_createMutex{ new std::mutex };
+        mutable std::vector< std::unique_ptr< const ParserKeyword > > m_createdKeywords;
+
+        // prefix trie of the literal prefixes of the wildcard keywords'
+        // regular expressions, so that only the keywords which can match a
+        // name are tried. The root node is the first one.
+        struct wildcard_node {
+            std::map< char, size_t > children;
+            std::vector< const ParserKeyword* > keywords;
+        };
+        std::vector< wildcard_node > m_wildCardTrie;
+
         bool hasWildCardKeyword(const std::string& keyword) const;
+        const ParserKeyword* deckKeyword(const string_view& deckKeywordName) const;
+        const ParserKeyword* createKeyword(const hashed_keyword& entry) const;
+        void addKeywordFactory(const KeywordFactory& factory);
         const ParserKeyword* matchingKeyword(const string_view& keyword) const;
+        void addWildCardKeyword(const ParserKeyword* keyword);
 
+        static const DeckNameHash& defaultDeckNames();
         void addDefaultKeywords();
     };
 
@@ -19,6 +19,7 @@
 #ifndef PARSER_KEYWORD_H
 #define PARSER_KEYWORD_H
 
+#include <cstdint>
 #include <iosfwd>
 #include <string>
 #include <memory>
@@ -94,6 +95,7 @@ namespace Opm {
         static bool validInternalName(const std::string& name);
         static bool validDeckName(const string_view& name);
         bool hasMatchRegex() const;
+        const std::string& getMatchRegex() const;
         void setMatchRegex(const std::string& deckNameRegexp);
         bool matches(const string_view& ) const;
         bool hasDimension() const;
@@ -131,6 +133,8 @@ namespace Opm {
         std::string createDeclaration(const std::string& indent) const;
         std::string createDecl() const;
         std::string createCode() const;
+        /* a hash of the full definition of the keyword, i.e. of createCode() */
+        uint64_t definitionHash() const;
         void applyUnitsToDeck( Deck& deck, DeckKeyword& deckKeyword) const;
 
         bool operator==( const ParserKeyword& ) const;
@@ -23,14 +23,13 @@
 #include <memory>
 #include <string>
 #include <vector>
-#include <list>
 
 #include <opm/parser/eclipse/RawDeck/RawEnums.hpp>
+#include <opm/parser/eclipse/RawDeck/RawRecord.hpp>
 #include <opm/parser/eclipse/Utility/Stringview.hpp>
 
 namespace Opm {
 
-    class RawRecord;
     class string_view;
 
     /// Class representing a RawKeyword, meaning both the actual keyword phrase, and the records,
@@ -43,6 +42,13 @@ namespace Opm {
         RawKeyword(const string_view& name , Raw::KeywordSizeEnum sizeType , const std::string& filename, size_t lineNR);
         RawKeyword(const string_view& name , const std::string& filename, size_t lineNR , size_t inputSize , bool isTableCollection = false);
 
+        /*
+          The parser creates the name of a file once, and shares it
+          between all the keywords and records of the file.
+        */
+        RawKeyword(const string_view& name , Raw::KeywordSizeEnum sizeType , std::shared_ptr< const std::string > filename, size_t lineNR);
+        RawKeyword(const string_view& name , std::shared_ptr< const std::string > filename, size_t lineNR , size_t inputSize , bool isTableCollection = false);
+
         const std::string& getKeywordName() const;
         void addRawRecordString( const string_view& );
         size_t size() const;
@@ -61,10 +67,11 @@ namespace Opm {
         void finalizeUnknownSize();
 
         const std::string& getFilename() const;
+        const std::shared_ptr< const std::string >& getSharedFilename() const;
         size_t getLineNR() const;
 
-        using const_iterator = std::list< RawRecord >::const_iterator;
-        using iterator = std::list< RawRecord >::iterator;
+        using const_iterator = std::vector< RawRecord >::const_iterator;
+        using iterator = std::vector< RawRecord >::iterator;
 
         const_iterator begin() const;
         const_iterator end() const;
@@ -80,14 +87,14 @@ namespace Opm {
         size_t m_numTables;
         size_t m_currentNumTables = 0;
         std::string m_name;
-        std::list< RawRecord > m_records;
+        std::vector< RawRecord > m_records;
         string_view m_partialRecordString;
 
         size_t m_lineNR;
-        std::string m_filename;
+        std::shared_ptr< const std::string > m_filename;
         bool m_is_title = false;
 
-        void commonInit(const std::string& name,const std::string& filename, size_t lineNR);
+        void commonInit(const std::string& name, std::shared_ptr< const std::string > filename, size_t lineNR);
         void setKeywordName(const std::string& keyword);
         static bool isValidKeyword(const std::string& keywordCandidate);
     };
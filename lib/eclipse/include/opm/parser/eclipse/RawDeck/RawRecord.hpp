@@ -20,10 +20,10 @@
 #ifndef RECORD_HPP
 #define RECORD_HPP
 
-#include <deque>
 #include <memory>
 #include <string>
-#include <list>
+#include <utility>
+#include <vector>
 
 #include <opm/parser/eclipse/Utility/Stringview.hpp>
 
@@ -35,13 +35,23 @@ namespace Opm {
 
     class RawRecord {
     public:
-        RawRecord( const string_view&, const std::string& fileName = "", const std::string& keywordName = "");
+        RawRecord( const string_view&,
+                   std::shared_ptr< const std::string > fileName = {},
+                   const std::string& keywordName = "");
+        RawRecord( const string_view&, const std::string& fileName, const std::string& keywordName = "");
 
         inline string_view pop_front();
         void push_front( string_view token );
         void prepend( size_t count, string_view token );
         inline size_t size() const;
 
+        /*
+         * Pop the remaining record string in one go, without splitting it
+         * into items. This is only possible if the items have not been
+         * accessed, otherwise false is returned and the record is unchanged.
+         */
+        bool popRecordString( string_view& );
+
         std::string getRecordString() const;
         inline string_view getItem(size_t index) const;
         const std::string& getFileName() const;
@@ -53,11 +63,26 @@ namespace Opm {
 
     private:
         string_view m_sanitizedRecordString;
-        std::deque< string_view > m_recordItems;
-        const std::string m_fileName;
-        const std::string m_keywordName;
+        /*
+         * The record string is split into items when they are first
+         * accessed, which large data records never are, see
+         * popRecordString. The items are consumed by advancing
+         * m_front rather than by erasing them, and the repetitions put
+         * back with prepend() are stored as (token, count) pairs, the
+         * last pair being the front of the record.
+         */
+        mutable std::vector< string_view > m_recordItems;
+        mutable bool m_split = false;
+        size_t m_front = 0;
+        std::vector< std::pair< string_view, size_t > > m_prepended;
+        size_t m_numPrepended = 0;
+        /* shared with the other keywords of the file */
+        std::shared_ptr< const std::string > m_fileName;
+        /* interned, shared with the other records of the keyword */
+        const std::string* m_keywordName;
 
         void setRecordString(const std::string& singleRecordString);
+        void split() const;
     };
 
     /*
@@ -65,17 +90,33 @@ namespace Opm {
      * inlining the calls gives a decent low-effort performance benefit.
      */
     string_view RawRecord::pop_front() {
-        auto front = m_recordItems.front();
-        this->m_recordItems.pop_front();
+        if( !this->m_split ) this->split();
+
+        if( this->m_numPrepended == 0 )
+            return this->m_recordItems[ this->m_front++ ];
+
+        auto& repeated = this->m_prepended.back();
+        const auto front = repeated.first;
+        --this->m_numPrepended;
+        if( --repeated.second == 0 ) this->m_prepended.pop_back();
         return front;
     }
 
     size_t RawRecord::size() const {
-        return m_recordItems.size();
+        if( !this->m_split ) this->split();
+
+        return this->m_numPrepended + this->m_recordItems.size() - this->m_front;
     }
 
     string_view RawRecord::getItem(size_t index) const {
-        return this->m_recordItems.at( index );
+        if( !this->m_split ) this->split();
+
+        for( auto it = this->m_prepended.rbegin(); it != this->m_prepended.rend(); ++it ) {
+            if( index < it->second ) return it->first;
+            index -= it->second;
+        }
+
+        return this->m_recordItems.at( this->m_front + index );
     }
 }
 
@@ -43,6 +43,8 @@ namespace Opm {
         bool operator==( const Dimension& ) const;
         bool operator!=( const Dimension& ) const;
 
+        friend class DeckCache;
+
     private:
         std::string m_name;
         double m_SIfactor;
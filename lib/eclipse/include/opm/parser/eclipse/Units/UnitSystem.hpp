@@ -98,6 +98,7 @@ namespace Opm {
         static UnitSystem newFIELD();
         static UnitSystem newLAB();
         static UnitSystem newPVT_M();
+        friend class DeckCache;
     private:
         Dimension parseFactor( const std::string& ) const;
 
@@ -0,0 +1,44 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_UTILITY_INTERN_HPP
+#define OPM_UTILITY_INTERN_HPP
+
+#include <string>
+
+namespace Opm {
+
+    /*
+     * Returns the process wide copy of str. Equal strings give the same
+     * reference, which stays valid for the lifetime of the program, so
+     * objects which are created in large numbers with a few distinct
+     * names - keyword and item names in the deck - can hold a pointer to
+     * the interned string instead of a copy of their own.
+     *
+     * The interned strings are never released, so intern() is meant for
+     * names from a fixed set, like those of the keyword definitions, not
+     * for input dependent strings such as file names. It is safe to call
+     * intern() from several threads; a thread only takes the lock of the
+     * shared table the first time it sees a string.
+     */
+    const std::string& intern( const std::string& str );
+
+}
+
+#endif //OPM_UTILITY_INTERN_HPP
@@ -155,3 +155,32 @@ BOOST_AUTO_TEST_CASE(AddCompletionCopy) {
     BOOST_CHECK_EQUAL( completion2 , copy.get(1));
     BOOST_CHECK_EQUAL( completion3 , copy.get(2));
 }
+
+BOOST_AUTO_TEST_CASE(AllCompletionsShutTracksUpdates) {
+    Opm::CompletionSet completionSet;
+    BOOST_CHECK( completionSet.allCompletionsShut() );
+
+    Opm::Completion open1( 10,10,10, 1, 0.0, Opm::WellCompletion::OPEN , Opm::Value<double>("ConnectionTransmissibilityFactor",99.88), Opm::Value<double>("D",22.33), Opm::Value<double>("SKIN",33.22), 0);
+    Opm::Completion shut1( 10,10,10, 1, 0.0, Opm::WellCompletion::SHUT , Opm::Value<double>("ConnectionTransmissibilityFactor",99.88), Opm::Value<double>("D",22.33), Opm::Value<double>("SKIN",33.22), 0);
+    Opm::Completion shut2( 10,10,11, 1, 0.0, Opm::WellCompletion::SHUT , Opm::Value<double>("ConnectionTransmissibilityFactor",99.88), Opm::Value<double>("D",22.33), Opm::Value<double>("SKIN",33.22), 0);
+    Opm::Completion auto2( 10,10,11, 1, 0.0, Opm::WellCompletion::AUTO , Opm::Value<double>("ConnectionTransmissibilityFactor",99.88), Opm::Value<double>("D",22.33), Opm::Value<double>("SKIN",33.22), 0);
+
+    completionSet.add( shut2 );
+    BOOST_CHECK( completionSet.allCompletionsShut() );
+
+    completionSet.add( open1 );
+    BOOST_CHECK( !completionSet.allCompletionsShut() );
+
+    completionSet.add( shut1 );
+    BOOST_CHECK( completionSet.allCompletionsShut() );
+
+    completionSet.add( auto2 );
+    BOOST_CHECK( !completionSet.allCompletionsShut() );
+
+    auto copy = completionSet;
+    BOOST_CHECK( !copy.allCompletionsShut() );
+
+    copy.add( shut2 );
+    BOOST_CHECK( copy.allCompletionsShut() );
+    BOOST_CHECK( !completionSet.allCompletionsShut() );
+}
@@ -0,0 +1,216 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE DeckCacheTests
+
+#include <cmath>
+#include <fstream>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <opm/json/JsonObject.hpp>
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Deck/DeckItem.hpp>
+#include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
+#include <opm/parser/eclipse/Deck/DeckRecord.hpp>
+#include <opm/parser/eclipse/Parser/DeckCache.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Units/UnitSystem.hpp>
+
+using namespace Opm;
+using namespace boost::filesystem;
+
+namespace {
+
+struct CacheFixture {
+    CacheFixture() :
+        root( temp_directory_path() / unique_path( "%%%%-%%%%" ) ),
+        data( ( root / "CASE.DATA" ).string() ),
+        cache( ( root / "CASE.cache" ).string() )
+    {
+        create_directories( root );
+        write( "CASE.DATA",
+               "RUNSPEC\n"
+               "FIELD\n"
+               "DIMENS\n 2 2 1 /\n"
+               "TABDIMS\n /\n"
+               "GRID\n"
+               "PERMX\n 1 2* 4 /\n"
+               "INCLUDE\n 'poro.inc' /\n"
+               "INCLUDE\n 'missing.inc' /\n"
+               "PROPS\n"
+               "DENSITY\n 50 1* 0.05 /\n" );
+
+        write( "poro.inc", "PORO\n 4*0.25 /\n" );
+
+        parseContext.update( ParseContext::PARSE_MISSING_INCLUDE, InputError::WARN );
+    }
+
+    ~CacheFixture() {
+        remove_all( root );
+    }
+
+    void write( const std::string& name, const std::string& content ) {
+        std::ofstream( ( root / name ).string() ) << content;
+    }
+
+    double poro() const {
+        return parser.parseFile( data, parseContext, cache )
+                     .getKeyword( "PORO" ).getSIDoubleData().front();
+    }
+
+    path root;
+    std::string data;
+    DeckCache cache;
+    Parser parser;
+    ParseContext parseContext;
+};
+
+void check_equal_decks( const Deck& parsed, const Deck& cached ) {
+    BOOST_CHECK_EQUAL( parsed.getDataFile(), cached.getDataFile() );
+    BOOST_CHECK( parsed.getActiveUnitSystem().getType() == cached.getActiveUnitSystem().getType() );
+    BOOST_CHECK( parsed.getDefaultUnitSystem().getType() == cached.getDefaultUnitSystem().getType() );
+
+    BOOST_REQUIRE_EQUAL( parsed.size(), cached.size() );
+    for( size_t i = 0; i < parsed.size(); ++i ) {
+        const auto& kw1 = parsed.getKeyword( i );
+        const auto& kw2 = cached.getKeyword( i );
+        BOOST_CHECK_EQUAL( kw1.name(), kw2.name() );
+        BOOST_CHECK_EQUAL( kw1.getFileName(), kw2.getFileName() );
+        BOOST_CHECK_EQUAL( kw1.getLineNumber(), kw2.getLineNumber() );
+        BOOST_CHECK( kw1.equal( kw2, true, true ) );
+
+        if( kw1.size() == 0 ) continue;
+
+        const auto& rec1 = kw1.getRecord( 0 );
+        const auto& rec2 = kw2.getRecord( 0 );
+        for( size_t j = 0; j < rec1.size(); ++j ) {
+            const auto& item1 = rec1.getItem( j );
+            const auto& item2 = rec2.getItem( j );
+            if( item1.getType() != type_tag::fdouble ) continue;
+
+            BOOST_CHECK_EQUAL( item1.size(), item2.size() );
+            for( size_t k = 0; k < item1.size(); ++k ) {
+                BOOST_CHECK_EQUAL( item1.defaultApplied( k ), item2.defaultApplied( k ) );
+                if( item1.hasValue( k ) && !std::isnan( item1.getSIDouble( k ) ) )
+                    BOOST_CHECK_EQUAL( item1.getSIDouble( k ), item2.getSIDouble( k ) );
+            }
+        }
+    }
+
+    const auto& msg1 = parsed.getMessageContainer();
+    const auto& msg2 = cached.getMessageContainer();
+    BOOST_REQUIRE_EQUAL( msg1.size(), msg2.size() );
+    for( auto it1 = msg1.begin(), it2 = msg2.begin(); it1 != msg1.end(); ++it1, ++it2 ) {
+        BOOST_CHECK_EQUAL( it1->mtype, it2->mtype );
+        BOOST_CHECK_EQUAL( it1->message, it2->message );
+        BOOST_CHECK_EQUAL( it1->location.filename, it2->location.filename );
+        BOOST_CHECK_EQUAL( it1->location.lineno, it2->location.lineno );
+    }
+}
+
+}
+
+BOOST_FIXTURE_TEST_CASE(CachedDeckEqualsParsedDeck, CacheFixture) {
+    const auto parsed = parser.parseFile( data, parseContext );
+    BOOST_CHECK( !exists( cache.path() ) );
+
+    check_equal_decks( parsed, parser.parseFile( data, parseContext, cache ) );
+    BOOST_CHECK( exists( cache.path() ) );
+
+    Deck cached;
+    BOOST_REQUIRE( cache.load( data, parser, parseContext, cached ) );
+    check_equal_decks( parsed, cached );
+}
+
+BOOST_FIXTURE_TEST_CASE(CacheValidatedByContentHash, CacheFixture) {
+    BOOST_CHECK_EQUAL( 0.25, poro() );
+
+    /* rewritten with the same size within the same second - the hash notices */
+    Deck deck;
+    const auto include = root / "poro.inc";
+    const auto mtime = last_write_time( include );
+    write( "poro.inc", "PORO\n 4*0.50 /\n" );
+    last_write_time( include, mtime );
+    BOOST_CHECK( !cache.load( data, parser, parseContext, deck ) );
+    BOOST_CHECK_EQUAL( 0.50, poro() );
+
+    /* touched but identical content - the cache is still valid */
+    write( "poro.inc", "PORO\n 4*0.50 /\n" );
+    last_write_time( include, mtime + 10 );
+    BOOST_CHECK( cache.load( data, parser, parseContext, deck ) );
+    BOOST_CHECK_EQUAL( 0.50, poro() );
+
+    write( "poro.inc", "PORO\n 4*0.125 /\n" );
+    BOOST_CHECK_EQUAL( 0.125, poro() );
+
+    /* a previously missing include appearing invalidates the cache */
+    write( "missing.inc", "NTG\n 4*0.5 /\n" );
+    BOOST_CHECK( !cache.load( data, parser, parseContext, deck ) );
+    BOOST_CHECK( parser.parseFile( data, parseContext, cache ).hasKeyword( "NTG" ) );
+    BOOST_CHECK( cache.load( data, parser, parseContext, deck ) );
+}
+
+BOOST_FIXTURE_TEST_CASE(CorruptCacheIgnored, CacheFixture) {
+    BOOST_CHECK_EQUAL( 0.25, poro() );
+
+    const auto size = file_size( cache.path() );
+    resize_file( cache.path(), size / 2 );
+
+    Deck deck;
+    BOOST_CHECK( !cache.load( data, parser, parseContext, deck ) );
+    BOOST_CHECK_EQUAL( 0.25, poro() );
+    BOOST_CHECK_EQUAL( size, file_size( cache.path() ) );
+
+    std::ofstream( cache.path() ) << "garbage";
+    BOOST_CHECK( !cache.load( data, parser, parseContext, deck ) );
+    BOOST_CHECK_EQUAL( 0.25, poro() );
+    BOOST_CHECK( cache.load( data, parser, parseContext, deck ) );
+}
+
+BOOST_FIXTURE_TEST_CASE(CacheTiedToParseContextAndDataFile, CacheFixture) {
+    BOOST_CHECK_EQUAL( 0.25, poro() );
+
+    Deck deck;
+    ParseContext other;
+    other.update( ParseContext::PARSE_MISSING_INCLUDE, InputError::IGNORE );
+    BOOST_CHECK( !cache.load( data, parser, other, deck ) );
+
+    write( "OTHER.DATA", "RUNSPEC\nDIMENS\n 2 2 1 /\n" );
+    BOOST_CHECK( !cache.load( ( root / "OTHER.DATA" ).string(), parser, parseContext, deck ) );
+    BOOST_CHECK( !cache.load( ( root / "NOSUCH.DATA" ).string(), parser, parseContext, deck ) );
+}
+
+BOOST_FIXTURE_TEST_CASE(CacheTiedToKeywordDefinitions, CacheFixture) {
+    BOOST_CHECK_EQUAL( 0.25, poro() );
+
+    Deck deck;
+    Parser other;
+    BOOST_CHECK_EQUAL( parser.definitionHash(), other.definitionHash() );
+    BOOST_CHECK( cache.load( data, other, parseContext, deck ) );
+
+    /* same deck names, different dimension of PORO */
+    other.addParserKeyword( Json::JsonObject( "{\"name\" : \"PORO\" , \"sections\" : [\"GRID\"], "
+                                              "\"data\" : {\"value_type\" : \"DOUBLE\" , \"default\" : 0 , \"dimension\":\"Length\"}}" ) );
+    BOOST_CHECK( parser.getAllDeckNames() == other.getAllDeckNames() );
+    BOOST_CHECK( parser.definitionHash() != other.definitionHash() );
+    BOOST_CHECK( !cache.load( data, other, parseContext, deck ) );
+}
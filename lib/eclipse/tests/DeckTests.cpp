@@ -18,6 +18,7 @@
  */
 
 
+#include <limits>
 #include <stdexcept>
 #include <sstream>
 
@@ -358,6 +359,63 @@ BOOST_AUTO_TEST_CASE(GetSIMultipleDim) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(ConvertToSI) {
+    DeckItem item( "HEI", double() );
+    Dimension celsius{ "AbsoluteTemperature" , 1, 273.15 };
+    Dimension length{ "Length" , 0.5 };
+
+    item.push_back( 2.0, 6 );
+    item.push_backDimension( celsius , celsius );
+    item.push_backDimension( length , length );
+    item.convertToSI();
+
+    const auto& si = item.getSIDoubleData();
+    BOOST_CHECK_EQUAL( 6U , si.size() );
+    for (size_t i=0; i < 6; i+= 2) {
+        BOOST_CHECK_EQUAL( 275.15 , si[i] );
+        BOOST_CHECK_EQUAL( 1.0    , si[i + 1] );
+    }
+    BOOST_CHECK_EQUAL( 2.0 , item.get< double >(0) );
+
+    /* values pushed after the conversion are converted on access */
+    item.push_back( 4.0 );
+    BOOST_CHECK_EQUAL( 277.15 , item.getSIDouble(6) );
+
+    /* or up front, also through a const reference */
+    item.push_back( 6.0 );
+    const auto& constItem = item;
+    constItem.convertToSI();
+    BOOST_CHECK_EQUAL( 3.0 , constItem.getSIDouble(7) );
+
+    /* with identity dimensions the SI data is the raw data */
+    DeckItem identity( "HEI", double() );
+    Dimension one{ "1" , 1 };
+    identity.push_back( 3.0, 10 );
+    identity.push_backDimension( one , one );
+    identity.convertToSI();
+    BOOST_CHECK_EQUAL( &identity.getData< double >() , &identity.getSIDoubleData() );
+
+    /* context dependent units are not converted */
+    DeckItem context( "HEI", double() );
+    Dimension unknown{ "ContextDependent" , std::numeric_limits< double >::quiet_NaN() };
+    context.push_back( 3.0 );
+    context.push_backDimension( unknown , unknown );
+    BOOST_CHECK_NO_THROW( context.convertToSI() );
+    BOOST_CHECK_THROW( context.getSIDoubleData() , std::logic_error );
+
+    /* but an empty context dependent item has nothing to convert */
+    DeckItem empty( "HEI", double() );
+    empty.push_backDimension( unknown , unknown );
+    BOOST_CHECK( empty.getSIDoubleData().empty() );
+
+    /* and a dimension no value uses is not looked at */
+    DeckItem unused( "HEI", double() );
+    unused.push_back( 2.0 );
+    unused.push_backDimension( length , length );
+    unused.push_backDimension( unknown , unknown );
+    BOOST_CHECK_EQUAL( 1.0 , unused.getSIDouble(0) );
+}
+
 BOOST_AUTO_TEST_CASE(HasValue) {
     DeckItem deckIntItem( "TEST", int() );
     BOOST_CHECK_EQUAL( false , deckIntItem.hasValue(0) );
@@ -17,6 +17,8 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cstdlib>
 #include <stdexcept>
 #include <iostream>
 #include <boost/filesystem.hpp>
@@ -273,3 +275,72 @@ BOOST_AUTO_TEST_CASE( update_elm ) {
     BOOST_CHECK_EQUAL( state[3],90  );
     BOOST_CHECK_EQUAL( state[4],139 );
 }
+
+
+BOOST_AUTO_TEST_CASE( run_length ) {
+    const std::time_t startDate = Opm::TimeMap::mkdate(2010, 1, 1);
+    Opm::TimeMap timeMap{ startDate };
+    for (size_t i = 0; i < 99; i++)
+        timeMap.addTStep((i+1) * 24 * 60 * 60);
+
+    /* compare against the plain vector the state used to be */
+    Opm::DynamicState<int> state(timeMap , 0);
+    std::vector< int > expected( timeMap.size(), 0 );
+
+    std::srand( 42 );
+    for( int i = 0; i < 500; ++i ) {
+        const size_t index = std::rand() % expected.size();
+        const int value = std::rand() % 4;
+
+        if( i % 3 == 0 ) {
+            state.update_elm( index, value );
+            expected[ index ] = value;
+        } else {
+            const bool change = value != expected[ index ];
+            BOOST_CHECK_EQUAL( change, state.update( index, value ) );
+            if( change )
+                std::fill( expected.begin() + index, expected.end(), value );
+        }
+
+        for( size_t j = 0; j < expected.size(); ++j )
+            BOOST_REQUIRE_EQUAL( expected[ j ], state[ j ] );
+
+        for( int v = 0; v < 4; ++v ) {
+            const auto it = std::find( expected.begin(), expected.end(), v );
+            const int pos = it == expected.end() ? -1 : it - expected.begin();
+            BOOST_CHECK_EQUAL( pos, state.find( v ) );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( change_points_shared ) {
+    const std::time_t startDate = Opm::TimeMap::mkdate(2010, 1, 1);
+    Opm::TimeMap timeMap{ startDate };
+    for (size_t i = 0; i < 1000; i++)
+        timeMap.addTStep((i+1) * 24 * 60 * 60);
+
+    Opm::DynamicState< std::vector< int > > state( timeMap, { 1 } );
+    state.update( 10, { 1, 2 } );
+    state.update( 20, { 1, 2 } );
+    state.update( 500, { 1 } );
+
+    /* one value per change point, not per timestep */
+    BOOST_CHECK_EQUAL( 3, std::distance( state.begin(), state.end() ) );
+    BOOST_CHECK( &state[ 10 ] == &state[ 499 ] );
+    BOOST_CHECK( &state[ 0 ] != &state[ 500 ] );
+
+    auto copy = state;
+    BOOST_CHECK( &copy[ 600 ] == &state[ 600 ] );
+
+    for( auto& v : copy ) v.push_back( 3 );
+    BOOST_CHECK_EQUAL( 2U, copy[ 600 ].size() );
+    BOOST_CHECK_EQUAL( 1U, state[ 600 ].size() );
+    BOOST_CHECK_EQUAL( 2U, state[ 10 ].size() );
+
+    copy.update_elm( 15, { 9 } );
+    BOOST_CHECK( &copy[ 14 ] == &copy[ 16 ] );
+    BOOST_CHECK_EQUAL( 5, std::distance( copy.begin(), copy.end() ) );
+    BOOST_CHECK_EQUAL( 9, copy[ 15 ].front() );
+    BOOST_CHECK_EQUAL( 10, state.find( { 1, 2 } ) );
+}
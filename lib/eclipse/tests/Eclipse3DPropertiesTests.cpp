@@ -700,3 +700,145 @@ BOOST_AUTO_TEST_CASE(DefaultedBoxFailMultiply) {
     // PORO has not been defined
     BOOST_CHECK_THROW( const Setup s(createMultiplyPorvFailDeck()), std::logic_error);
 }
+
+static Opm::Deck createRegionRecordsDeck() {
+    const char* input = R"(
+RUNSPEC
+
+DIMENS
+  6 1 1 /
+
+GRID
+
+DX
+  6*0.25 /
+DY
+  6*0.25 /
+DZ
+  6*0.25 /
+TOPS
+  6*0.25 /
+
+PORO
+  6*0.5 /
+
+REGIONS
+
+MULTNUM
+  1 1 2 2 3 4 /
+
+FLUXNUM
+  1 2 3 4 5 6 /
+
+EQUALREG
+  SATNUM 7 1 M /
+  SATNUM 8 2 M /
+  SATNUM 9 1 M /
+/
+
+MULTIREG
+  SATNUM 2 1 M /
+  SATNUM 3 1 M /
+  SATNUM 5 3 M /
+/
+
+ADDREG
+  SATNUM 1 2 M /
+  SATNUM 2 2 M /
+  SATNUM 1 4 M /
+/
+
+COPYREG
+  SATNUM IMBNUM 1 M /
+  SATNUM IMBNUM 4 M /
+/
+
+EQUALREG
+  MULTNUM 2 1 M /
+  MULTNUM 3 2 M /
+  MULTNUM 6 3 M /
+/
+
+MULTIREG
+  PORO 0.5 4 M /
+  PORO 0.5 3 F /
+/
+)";
+
+    Opm::Parser parser;
+    return parser.parseString(input, Opm::ParseContext() );
+}
+
+BOOST_AUTO_TEST_CASE(RegionRecordsAppliedInOrder) {
+    Setup s(createRegionRecordsDeck());
+
+    /* the later records of a keyword override or add to the earlier ones */
+    const std::vector< int > satnum = { 54, 54, 11, 11, 5, 2 };
+    const std::vector< int > imbnum = { 54, 54, 1, 1, 1, 2 };
+    BOOST_CHECK( satnum == s.props.getIntGridProperty("SATNUM").getData() );
+    BOOST_CHECK( imbnum == s.props.getIntGridProperty("IMBNUM").getData() );
+
+    /* a record modifying its own region array is seen by the next record */
+    const std::vector< int > multnum = { 6, 6, 6, 6, 6, 4 };
+    BOOST_CHECK( multnum == s.props.getIntGridProperty("MULTNUM").getData() );
+
+    /* records using different region arrays are applied in order */
+    const std::vector< double > poro = { 0.5, 0.5, 0.25, 0.5, 0.5, 0.25 };
+    const auto& data = s.props.getDoubleGridProperty("PORO").getData();
+    for (size_t g = 0; g < poro.size(); g++)
+        BOOST_CHECK_CLOSE( poro[g], data[g], 1e-12 );
+}
+
+static Opm::Deck createRegionArithmeticDeck() {
+    const char* input = R"(
+RUNSPEC
+
+DIMENS
+  6 1 1 /
+
+GRID
+
+DX
+  6*0.25 /
+DY
+  6*0.25 /
+DZ
+  6*0.25 /
+TOPS
+  6*0.25 /
+
+PORO
+  0.9 0.7 4*0.5 /
+
+REGIONS
+
+FLUXNUM
+  1 2 3 4 5 6 /
+
+ADDREG
+  PORO 0.1 1 F /
+  PORO 0.2 1 F /
+/
+
+MULTIREG
+  PORO 0.1 2 F /
+  PORO 3   2 F /
+/
+)";
+
+    Opm::Parser parser;
+    return parser.parseString(input, Opm::ParseContext() );
+}
+
+BOOST_AUTO_TEST_CASE(RegionRecordsRoundedInOrder) {
+    Setup s(createRegionArithmeticDeck());
+
+    /*
+      The shifts and factors are applied one record at a time; adding
+      0.1 + 0.2 or multiplying 0.1 * 3 first would round differently.
+    */
+    const auto& poro = s.props.getDoubleGridProperty("PORO").getData();
+    BOOST_CHECK_EQUAL( (0.9 + 0.1) + 0.2, poro[0] );
+    BOOST_CHECK_EQUAL( (0.7 * 0.1) * 3, poro[1] );
+    BOOST_CHECK_EQUAL( 0.5, poro[2] );
+}
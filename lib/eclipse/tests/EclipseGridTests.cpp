@@ -19,6 +19,8 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <sstream>
+#include <thread>
 #include <boost/filesystem.hpp>
 #include <cstdio>
 
@@ -1395,3 +1397,124 @@ BOOST_AUTO_TEST_CASE(CoordMapper) {
 
     BOOST_CHECK_EQUAL( cmp.index(10,7,2,1) + 1 , cmp.size( ));
 }
+
+BOOST_AUTO_TEST_CASE(ExportCellGeometry) {
+    std::ostringstream deckData;
+    deckData << "RUNSPEC\n"
+             << "DIMENS\n"
+             << " 40 40 10 /\n"
+             << "GRID\n"
+             << "DXV\n"
+             << "10*1 10*2 20*3 /\n"
+             << "DYV\n"
+             << "40*0.5 /\n"
+             << "DZV\n"
+             << "5*1 5*4 /\n"
+             << "TOPS\n";
+    for (int g = 0; g < 1600; g++)
+        deckData << 100 + g % 40 << " ";
+    deckData << "/\n";
+
+    Opm::Parser parser;
+    const auto deck = parser.parseString(deckData.str(), Opm::ParseContext());
+    Opm::EclipseGrid grid(deck);
+
+    std::vector<double> volume, depth, thickness;
+    grid.exportCellGeometry(volume, depth, thickness);
+    BOOST_CHECK_EQUAL(volume.size(), grid.getCartesianSize());
+    BOOST_CHECK_EQUAL(depth.size(), grid.getCartesianSize());
+    BOOST_CHECK_EQUAL(thickness.size(), grid.getCartesianSize());
+
+    for (size_t g = 0; g < grid.getCartesianSize(); g++) {
+        BOOST_CHECK_EQUAL(volume[g], grid.getCellVolume(g));
+        BOOST_CHECK_EQUAL(depth[g], grid.getCellDepth(g));
+        BOOST_CHECK_EQUAL(thickness[g], grid.getCellThicknes(g));
+    }
+
+    std::vector<double> volume4, depth4, thickness4;
+    grid.exportCellGeometry(volume4, depth4, thickness4, 4);
+    BOOST_CHECK(volume == volume4);
+    BOOST_CHECK(depth == depth4);
+    BOOST_CHECK(thickness == thickness4);
+}
+
+
+BOOST_AUTO_TEST_CASE(CellGeometryCache) {
+    std::ostringstream deckData;
+    deckData << "RUNSPEC\n"
+             << "DIMENS\n"
+             << " 40 40 10 /\n"
+             << "GRID\n"
+             << "DXV\n"
+             << "10*1 10*2 20*3 /\n"
+             << "DYV\n"
+             << "40*0.5 /\n"
+             << "DZV\n"
+             << "5*1 5*4 /\n"
+             << "TOPS\n";
+    for (int g = 0; g < 1600; g++)
+        deckData << 100 + g % 40 << " ";
+    deckData << "/\n";
+
+    Opm::Parser parser;
+    const auto deck = parser.parseString(deckData.str(), Opm::ParseContext());
+    std::vector<int> actnum(16000, 1);
+    for (size_t g = 0; g < actnum.size(); g += 7)
+        actnum[g] = 0;
+
+    Opm::EclipseGrid grid(deck, actnum.data());
+    const auto& centers = grid.getCellCenters(4);
+    const auto& dims = grid.getCellDimensions(4);
+    const auto& volumes = grid.getCellVolumes(4);
+    const auto& depths = grid.getCellDepths(4);
+
+    std::vector<double> volume, depth, thickness;
+    grid.exportCellGeometry(volume, depth, thickness);
+    BOOST_CHECK(volumes == volume);
+    BOOST_CHECK(depths == depth);
+    BOOST_CHECK(dims[2] == thickness);
+
+    for (size_t g = 0; g < grid.getCartesianSize(); g += 13) {
+        double x, y, z;
+        ecl_grid_get_xyz1(grid.c_ptr(), static_cast<int>(g), &x, &y, &z);
+        BOOST_CHECK_EQUAL(x, centers[0][g]);
+        BOOST_CHECK_EQUAL(y, centers[1][g]);
+        BOOST_CHECK_EQUAL(z, centers[2][g]);
+        BOOST_CHECK_EQUAL(ecl_grid_get_cell_dx1(grid.c_ptr(), static_cast<int>(g)), dims[0][g]);
+        BOOST_CHECK_EQUAL(ecl_grid_get_cell_dy1(grid.c_ptr(), static_cast<int>(g)), dims[1][g]);
+
+        const auto center = grid.getCellCenter(g);
+        BOOST_CHECK_EQUAL(x, center[0]);
+        BOOST_CHECK_EQUAL(y, center[1]);
+        BOOST_CHECK_EQUAL(z, center[2]);
+    }
+
+    /* same values when computed serially, and in copies of the grid */
+    Opm::EclipseGrid serial(deck, actnum.data());
+    BOOST_CHECK(serial.getCellCenters() == centers);
+    BOOST_CHECK(serial.getCellDimensions() == dims);
+    BOOST_CHECK(serial.getCellDepths() == depths);
+
+    Opm::EclipseGrid copy(grid);
+    BOOST_CHECK(copy.getCellVolumes() == volumes);
+    BOOST_CHECK(copy.getCellVolume(3, 4, 5) == grid.getCellVolume(3, 4, 5));
+
+    /* the caches of a grid with new actnum start out empty */
+    Opm::EclipseGrid allActive(grid, std::vector<int>(16000, 1));
+    BOOST_CHECK_EQUAL(allActive.getActiveMap().size(), 16000U);
+    BOOST_CHECK(allActive.getCellDepths() == depths);
+
+    /* concurrent first use of the active map */
+    Opm::EclipseGrid shared(grid, actnum);
+    std::vector<const std::vector<int>*> maps(4);
+    std::vector<std::thread> readers;
+    for (size_t t = 0; t < maps.size(); t++)
+        readers.emplace_back([&shared, &maps, t] { maps[t] = &shared.getActiveMap(); });
+    for (auto& reader : readers)
+        reader.join();
+
+    const auto& activeMap = grid.getActiveMap();
+    BOOST_CHECK_EQUAL(activeMap.size(), grid.getNumActive());
+    for (const auto* map : maps)
+        BOOST_CHECK(*map == activeMap);
+}
@@ -318,6 +318,26 @@ BOOST_AUTO_TEST_CASE(GetFaults) {
 }
 
 
+BOOST_AUTO_TEST_CASE(ConcurrentConstruction) {
+    auto deck = createDeck();
+    EclipseState serial( deck, ParseContext() );
+    EclipseState concurrent( deck, ParseContext(), 4 );
+
+    BOOST_CHECK_EQUAL( serial.getTitle(), concurrent.getTitle() );
+    BOOST_CHECK_EQUAL( serial.runspec().phases().size(), concurrent.runspec().phases().size() );
+    BOOST_CHECK_EQUAL( serial.getInputGrid().getNumActive(),
+                       concurrent.getInputGrid().getNumActive() );
+    BOOST_CHECK_EQUAL( serial.getInputNNC().numNNC(), concurrent.getInputNNC().numNNC() );
+    BOOST_CHECK_EQUAL( serial.getFaults().size(), concurrent.getFaults().size() );
+    BOOST_CHECK_EQUAL( 0.25, concurrent.getFaults().getFault( "F2" ).getTransMult() );
+    BOOST_CHECK_EQUAL( concurrent.getTransMult().getMultiplier( 4, 3, 0, FaceDir::XMinus ), 0.25 );
+    BOOST_CHECK_EQUAL( serial.getRestartConfig().getFirstRestartStep(),
+                       concurrent.getRestartConfig().getFirstRestartStep() );
+
+    const auto& satnum = serial.get3DProperties().getIntGridProperty( "SATNUM" ).getData();
+    BOOST_CHECK( satnum == concurrent.get3DProperties().getIntGridProperty( "SATNUM" ).getData() );
+}
+
 BOOST_AUTO_TEST_CASE(FaceTransMults) {
     auto deck = createDeckNoFaults();
     EclipseState state(deck, ParseContext());
@@ -45,6 +45,7 @@ BOOST_AUTO_TEST_CASE( CheckUnsoppertedInSCHEDULE ) {
         "START\n"
         " 10 'JAN' 2000 /\n"
         "RUNSPEC\n"
+        "FIELD\n"
         "DIMENS\n"
         "  10 10 10 / \n"
         "GRID\n"
@@ -88,10 +89,14 @@ BOOST_AUTO_TEST_CASE( CheckUnsoppertedInSCHEDULE ) {
 
         BOOST_CHECK_EQUAL( 0U, schedule.getModifierDeck(1).size() );
         BOOST_CHECK_EQUAL( 0U, schedule.getModifierDeck(3).size() );
+        BOOST_CHECK_EQUAL( &schedule.getModifierDeck(1), &schedule.getModifierDeck(3) );
+        BOOST_CHECK_THROW( schedule.getModifierDeck(5), std::out_of_range );
 
         const Deck& multflt_deck = schedule.getModifierDeck(2);
         BOOST_CHECK_EQUAL( 2U , multflt_deck.size());
         BOOST_CHECK( multflt_deck.hasKeyword<ParserKeywords::MULTFLT>() );
+        BOOST_CHECK( multflt_deck.getActiveUnitSystem() == deck.getActiveUnitSystem() );
+        BOOST_CHECK( UnitSystem::UnitType::UNIT_TYPE_FIELD == multflt_deck.getActiveUnitSystem().getType() );
 
         const auto& multflt1 = multflt_deck.getKeyword(0);
         BOOST_CHECK_EQUAL( 1U , multflt1.size( ) );
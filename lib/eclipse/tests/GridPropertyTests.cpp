@@ -444,6 +444,111 @@ BOOST_AUTO_TEST_CASE(GridPropertyInitialization) {
 }
 
 
+BOOST_AUTO_TEST_CASE(CompressedProperty) {
+    typedef Opm::GridProperty<int>::SupportedKeywordInfo SupportedKeywordInfo;
+    SupportedKeywordInfo keywordInfo("P" , 10 , "1");
+    Opm::GridProperty<int> p( 2 , 2 , 1 , keywordInfo);
+    for (size_t g = 0; g < 4; g++)
+        p.iset( g , g + 1 );
+
+    auto activeIndex = std::make_shared< std::vector< int > >( std::vector< int >{ 0 , -1 , 1 , -1 } );
+    p.compress( activeIndex );
+
+    BOOST_CHECK( p.isCompressed() );
+    BOOST_CHECK_EQUAL( p.getCartesianSize() , 4U );
+    BOOST_CHECK( p.getCompressedData() == std::vector< int >({ 1 , 3 }) );
+    BOOST_CHECK_EQUAL( p.iget( 0 ) , 1 );
+    BOOST_CHECK_EQUAL( p.iget( 1 ) , 0 );
+    BOOST_CHECK_EQUAL( p.iget( 1 , 1 , 0 ) , 0 );
+    BOOST_CHECK_THROW( p.iget( 4 ) , std::out_of_range );
+
+    p.iset( 2 , 7 );
+    BOOST_CHECK_EQUAL( p.iget( 2 ) , 7 );
+    BOOST_CHECK_THROW( p.iset( 3 , 7 ) , std::invalid_argument );
+
+    BOOST_CHECK_THROW( p.getData() , std::logic_error );
+    BOOST_CHECK_THROW( p.setScalar( 1 , Opm::Box( 2 , 2 , 1 ) ) , std::logic_error );
+    BOOST_CHECK_THROW( p.compress( activeIndex ) , std::logic_error );
+    BOOST_CHECK( p.indexEqual( 0 ) == std::vector< size_t >({ 1 , 3 }) );
+
+    Opm::GridProperty<int> q( 2 , 2 , 2 , keywordInfo);
+    BOOST_CHECK_THROW( q.compress( activeIndex ) , std::invalid_argument );
+}
+
+
+BOOST_AUTO_TEST_CASE(CompressedProperties) {
+    const char* deckString =
+        "RUNSPEC\n"
+        "OIL\n"
+        "GAS\n"
+        "WATER\n"
+        "TABDIMS\n"
+        "2 /\n"
+        "DIMENS\n"
+        "2 2 2 /\n"
+        "GRID\n"
+        "ACTNUM\n"
+        " 0 1 1 1 1 1 1 0 /\n"
+        "DXV\n"
+        "1 1 /\n"
+        "DYV\n"
+        "1 1 /\n"
+        "DZV\n"
+        "1 1 /\n"
+        "TOPS\n"
+        "4*100 /\n"
+        "PERMX\n"
+        "1 2 3 4 5 6 7 8 /\n"
+        "PROPS\n"
+        "SWOF\n"
+        "  0.1    0        1.0      2.0\n"
+        "  0.93   0.91     0.0      0.0\n"
+        "/\n"
+        "  0.2    0        1.0      2.0\n"
+        "  0.852  1.00     0.0      0.0\n"
+        "/\n"
+        "SGOF\n"
+        "  0.00   0.00     0.9      2.0\n"
+        "  0.80   1.00     0.0      0.0\n"
+        "/\n"
+        "  0.05   0.00     1.0      2\n"
+        "  0.85   1.00     0.0      0\n"
+        "/\n"
+        "REGIONS\n"
+        "SATNUM\n"
+        "4*1 4*2 /\n";
+
+    auto deck = Opm::Parser().parseString(deckString, Opm::ParseContext());
+    Opm::TableManager tm(deck);
+    Opm::EclipseGrid eg(deck);
+    Opm::Eclipse3DProperties full(deck, tm, eg);
+    Opm::Eclipse3DProperties props(deck, tm, eg);
+
+    props.compress( eg );
+    BOOST_CHECK_THROW( props.compress( eg ) , std::logic_error );
+
+    /* SWL and IMBNUM are auto created after the compression */
+    for (const auto& kw : { "PERMX" , "SWL" , "ISWL" }) {
+        const auto& property = props.getDoubleGridProperty( kw );
+        const auto& reference = full.getDoubleGridProperty( kw );
+
+        BOOST_CHECK( property.isCompressed() );
+        BOOST_CHECK( property.getCompressedData() == reference.compressedCopy( eg ) );
+        BOOST_CHECK( property.compressedCopy( eg ) == reference.compressedCopy( eg ) );
+        BOOST_CHECK_THROW( property.getData() , std::logic_error );
+
+        for (size_t g = 0; g < eg.getCartesianSize(); g++)
+            BOOST_CHECK_EQUAL( property.iget( g ) , eg.cellActive( g ) ? reference.iget( g ) : 0 );
+    }
+
+    const auto& satnum = props.getIntGridProperty( "SATNUM" );
+    BOOST_CHECK( satnum.cellsEqual( 2 , eg ) == full.getIntGridProperty( "SATNUM" ).cellsEqual( 2 , eg ) );
+    BOOST_CHECK( props.getRegions( "SATNUM" ) == std::vector< int >({ 1 , 2 }) );
+    BOOST_CHECK_EQUAL( props.getIntGridProperty( "ACTNUM" ).iget( 0 ) , 0 );
+    BOOST_CHECK_EQUAL( props.getIntGridProperty( "ACTNUM" ).iget( 1 ) , 1 );
+}
+
+
 inline void TestPostProcessorMul(std::vector< double >& values,
         const Opm::TableManager*,
         const Opm::EclipseGrid*,
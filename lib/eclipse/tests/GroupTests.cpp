@@ -390,6 +390,21 @@ BOOST_AUTO_TEST_CASE(UpdateTree_ParentNotAdded_ChildAndParentAdded) {
     BOOST_CHECK_EQUAL( "CHILD", tree.children( "NEWPARENT" ).front() );
 }
 
+BOOST_AUTO_TEST_CASE(GroupTree_AllChildren) {
+    GroupTree tree;
+    tree.update("PLATFORM", "FIELD");
+    tree.update("B", "PLATFORM");
+    tree.update("A", "PLATFORM");
+    tree.update("C", "FIELD");
+
+    const auto children = tree.children();
+    BOOST_CHECK_EQUAL( 2U, children.size() );
+    for( const auto& parent : { "FIELD", "PLATFORM" } )
+        BOOST_CHECK( children.at( parent ) == tree.children( parent ) );
+
+    BOOST_CHECK( children.find( "A" ) == children.end() );
+}
+
 BOOST_AUTO_TEST_CASE(UpdateTree_AddFieldNode_Throws) {
     GroupTree tree;
     BOOST_CHECK_THROW(tree.update("FIELD", "NEWPARENT"), std::invalid_argument );
@@ -0,0 +1,100 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#define BOOST_TEST_MODULE InternTests
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/Deck/DeckItem.hpp>
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Utility/Intern.hpp>
+
+using namespace Opm;
+
+BOOST_AUTO_TEST_CASE(InternSharesEqualStrings) {
+    const std::string name = "WCONHIST";
+    const auto& interned = intern( name );
+
+    BOOST_CHECK_EQUAL( name, interned );
+    BOOST_CHECK( &name != &interned );
+    BOOST_CHECK_EQUAL( &interned, &intern( std::string( "WCONHIST" ) ) );
+    BOOST_CHECK( &interned != &intern( "WCONPROD" ) );
+    BOOST_CHECK_EQUAL( "", intern( "" ) );
+}
+
+BOOST_AUTO_TEST_CASE(InternAcrossThreads) {
+    std::vector< const std::string* > interned( 4 );
+    std::vector< std::thread > threads;
+    for( size_t t = 0; t < interned.size(); ++t )
+        threads.emplace_back( [&interned, t] {
+            for( int i = 0; i < 1000; ++i )
+                intern( "ITEM" + std::to_string( i ) );
+
+            interned[ t ] = &intern( "COMPDAT" );
+        } );
+
+    for( auto& thread : threads )
+        thread.join();
+
+    for( const auto* str : interned )
+        BOOST_CHECK_EQUAL( str, &intern( "COMPDAT" ) );
+
+    BOOST_CHECK_EQUAL( &intern( "ITEM17" ), &intern( "ITEM" + std::to_string( 17 ) ) );
+}
+
+BOOST_AUTO_TEST_CASE(DeckNamesAreShared) {
+    DeckItem item1( "WELL", std::string() );
+    DeckItem item2( std::string( "WELL" ), std::string() );
+    BOOST_CHECK_EQUAL( "WELL", item1.name() );
+    BOOST_CHECK_EQUAL( &item1.name(), &item2.name() );
+    BOOST_CHECK_EQUAL( "", DeckItem().name() );
+
+    DeckKeyword kw1( "COMPDAT" );
+    DeckKeyword kw2( "COMPDAT" );
+    BOOST_CHECK_EQUAL( &kw1.name(), &kw2.name() );
+    BOOST_CHECK_EQUAL( "", DeckKeyword( "TITLE" ).getFileName() );
+}
+
+BOOST_AUTO_TEST_CASE(FileNamesAreSharedPerFile) {
+    std::weak_ptr< const std::string > released;
+    {
+        const auto file = std::make_shared< const std::string >( "/path/to/CASE.DATA" );
+        released = file;
+
+        DeckKeyword kw1( "COMPDAT" );
+        DeckKeyword kw2( "COMPDAT" );
+        kw1.setLocation( file, 10 );
+        kw2.setLocation( file, 20 );
+        BOOST_CHECK_EQUAL( &kw1.getFileName(), &kw2.getFileName() );
+        BOOST_CHECK_EQUAL( "/path/to/CASE.DATA", kw2.getFileName() );
+    }
+
+    /* file names are not interned, they go away with the keywords */
+    BOOST_CHECK( released.expired() );
+
+    const auto deck = Parser().parseString( "RUNSPEC\nOIL\nGAS\n", ParseContext() );
+    BOOST_CHECK_EQUAL( &deck.getKeyword( 0 ).getFileName(), &deck.getKeyword( 2 ).getFileName() );
+}
@@ -19,6 +19,7 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <sstream>
 #include <boost/filesystem.hpp>
 
 #define BOOST_TEST_MODULE MULTREGTScannerTests
@@ -39,6 +40,7 @@
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/Box.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/FaceDir.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/NNC.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
 
 
@@ -264,3 +266,119 @@ BOOST_AUTO_TEST_CASE(MULTREGT_COPY_MULTNUM) {
         BOOST_CHECK_EQUAL(fdata[i], data[i]);
     }
 }
+
+
+static Opm::Deck createLargeMULTREGTDeck() {
+    const size_t nx = 40, ny = 40, nz = 6;
+    std::ostringstream deckData;
+    deckData << "RUNSPEC\n"
+             << "DIMENS\n" << nx << " " << ny << " " << nz << " /\n"
+             << "GRID\n"
+             << "DX\n" << nx * ny * nz << "*0.25 /\n"
+             << "DY\n" << nx * ny * nz << "*0.25 /\n"
+             << "DZ\n" << nx * ny * nz << "*0.25 /\n"
+             << "TOPS\n" << nx * ny << "*0.25 /\n";
+
+    deckData << "FLUXNUM\n";
+    for (size_t k = 0; k < nz; k++)
+        for (size_t j = 0; j < ny; j++)
+            for (size_t i = 0; i < nx; i++)
+                deckData << 1 + (i / 7 + j / 9 + k) % 5 << "\n";
+    deckData << "/\n";
+
+    deckData << "MULTNUM\n";
+    for (size_t g = 0; g < nx * ny * nz; g++)
+        deckData << 1 + g % 3 << "\n";
+    deckData << "/\n";
+
+    deckData << "MULTREGT\n"
+             << "1  2   0.10   X     NONNC  F /\n"
+             << "2  3   0.20   XY    NNC    F /\n"
+             << "3  1   0.30   XYZ   ALL    F /\n"
+             << "5  4   0.40   Z     ALL    F /\n"
+             << "1  3   0.50   Y     ALL    M /\n"
+             << "2  1   0.60   XYZ   ALL    M /\n"
+             << "/\n"
+             << "EDIT\n";
+
+    Opm::Parser parser;
+    return parser.parseString(deckData.str(), Opm::ParseContext()) ;
+}
+
+BOOST_AUTO_TEST_CASE(BulkRegionMultipliers) {
+    Opm::Deck deck = createLargeMULTREGTDeck();
+    Opm::TableManager tm(deck);
+    Opm::EclipseGrid eg(deck);
+    Opm::Eclipse3DProperties props(deck, tm, eg);
+    Opm::MULTREGTScanner scanner( props, deck.getKeywordList( "MULTREGT" ) );
+
+    const size_t nx = eg.getNX(), ny = eg.getNY(), nz = eg.getNZ();
+    const std::vector< std::pair< Opm::FaceDir::DirEnum, size_t > > faces =
+        { { Opm::FaceDir::XPlus, 1 }, { Opm::FaceDir::YPlus, nx }, { Opm::FaceDir::ZPlus, nx * ny } };
+
+    for (const auto& face : faces) {
+        const auto multipliers = scanner.getRegionMultipliers( eg, face.first, 4 );
+        BOOST_CHECK( multipliers == scanner.getRegionMultipliers( eg, face.first ) );
+        BOOST_REQUIRE_EQUAL( nx * ny * nz, multipliers.size() );
+
+        size_t changed = 0;
+        for (size_t g = 0; g < multipliers.size(); g++) {
+            const auto ijk = eg.getIJK( g );
+            const bool boundary = (face.first == Opm::FaceDir::XPlus && size_t( ijk[0] ) + 1 == nx)
+                               || (face.first == Opm::FaceDir::YPlus && size_t( ijk[1] ) + 1 == ny)
+                               || (face.first == Opm::FaceDir::ZPlus && size_t( ijk[2] ) + 1 == nz);
+
+            const double expected = boundary ? 1.0
+                                  : scanner.getRegionMultiplier( g, g + face.second, face.first );
+            BOOST_CHECK_EQUAL( expected, multipliers[g] );
+            if (multipliers[g] != 1.0) changed++;
+        }
+        BOOST_CHECK( changed > 0 );
+    }
+
+    BOOST_CHECK_THROW( scanner.getRegionMultipliers( eg, Opm::FaceDir::XMinus ), std::invalid_argument );
+    BOOST_CHECK_THROW( scanner.getRegionMultipliers( Opm::GridDims( 2, 2, 2 ), Opm::FaceDir::XPlus ), std::invalid_argument );
+
+    Opm::NNC nnc;
+    nnc.addNNC( 0, 2 * nx + 5, 1.0 );
+    nnc.addNNC( 3, 3 + nx * ny, 1.0 );
+    nnc.addNNC( 7, 1 + 5 * nx, 1.0 );
+    const auto nncMultipliers = scanner.getRegionMultipliers( eg, nnc );
+    BOOST_CHECK_EQUAL( scanner.getRegionMultiplier( 0, 2 * nx + 5, Opm::FaceDir::XPlus ), nncMultipliers[0] );
+    BOOST_CHECK_EQUAL( scanner.getRegionMultiplier( 3, 3 + nx * ny, Opm::FaceDir::ZPlus ), nncMultipliers[1] );
+    BOOST_CHECK_EQUAL( scanner.getRegionMultiplier( 7, 1 + 5 * nx, Opm::FaceDir::XPlus ), nncMultipliers[2] );
+}
+
+BOOST_AUTO_TEST_CASE(SparseRegionValues) {
+    /* the region table does not grow with the largest region value */
+    const char* deckData =
+        "RUNSPEC\n"
+        "DIMENS\n"
+        " 3 1 1 /\n"
+        "GRID\n"
+        "DX\n"
+        " 3*0.25 /\n"
+        "DY\n"
+        " 3*0.25 /\n"
+        "DZ\n"
+        " 3*0.25 /\n"
+        "TOPS\n"
+        " 3*0.25 /\n"
+        "FLUXNUM\n"
+        " 7 2000000000 7 /\n"
+        "MULTREGT\n"
+        " 7  2000000000  0.50  X  ALL  F /\n"
+        "/\n"
+        "EDIT\n";
+
+    Opm::Parser parser;
+    Opm::Deck deck = parser.parseString( deckData, Opm::ParseContext() );
+    Opm::TableManager tm(deck);
+    Opm::EclipseGrid eg(deck);
+    Opm::Eclipse3DProperties props(deck, tm, eg);
+    Opm::MULTREGTScanner scanner( props, deck.getKeywordList( "MULTREGT" ) );
+
+    BOOST_CHECK_EQUAL( 0.50, scanner.getRegionMultiplier( 0, 1, Opm::FaceDir::XPlus ) );
+    BOOST_CHECK_EQUAL( 0.50, scanner.getRegionMultiplier( 1, 2, Opm::FaceDir::XPlus ) );
+    BOOST_CHECK_EQUAL( 1.0, scanner.getRegionMultiplier( 0, 2, Opm::FaceDir::XPlus ) );
+}
@@ -19,6 +19,7 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <sstream>
 #include <boost/filesystem.hpp>
 
 #define BOOST_TEST_MODULE PORVTESTS
@@ -464,3 +465,81 @@ BOOST_AUTO_TEST_CASE(PORO_ZERO_ACTNUM_CORRECT) {
 
     BOOST_CHECK_EQUAL( grid.getNumActive() , 700U );
 }
+
+
+static Opm::Deck createLargeMULTREGPDeck() {
+    std::ostringstream deckData;
+    deckData << "RUNSPEC\n"
+             << "DIMENS\n"
+             << " 40 40 10 /\n"
+             << "GRID\n"
+             << "DXV\n"
+             << "40*0.25 /\n"
+             << "DYV\n"
+             << "40*0.5 /\n"
+             << "DZV\n"
+             << "10*0.125 /\n"
+             << "TOPS\n"
+             << "1600*100 /\n"
+             << "PORO\n";
+    for (int g = 0; g < 16000; g++)
+        deckData << 0.05 + 0.01 * (g % 17) << " ";
+    deckData << "/\n"
+             << "NTG\n"
+             << "8000*0.5 8000*0.75 /\n"
+             << "MULTPV\n"
+             << "4000*1 4000*3 8000*1 /\n"
+             << "BOX\n"
+             << "1 40 1 40 1 1 /\n"
+             << "PORV\n"
+             << "1600*77 /\n"
+             << "ENDBOX\n"
+             << "MULTNUM\n";
+    for (int g = 0; g < 16000; g++)
+        deckData << 1 + g % 5 << " ";
+    deckData << "/\n"
+             << "FLUXNUM\n";
+    for (int g = 0; g < 16000; g++)
+        deckData << 1 + (g / 40) % 7 << " ";
+    deckData << "/\n"
+             << "MULTREGP\n"
+             << "1 10.0 F / \n"
+             << "2 3.0 M / \n"
+             << "5 0.25 F / \n"
+             << "6 1.5 F / \n"
+             << "4 0.1 M / \n"
+             << "7 0.3 M / \n"
+             << "/\n";
+
+    Opm::Parser parser;
+    return parser.parseString(deckData.str(), Opm::ParseContext()) ;
+}
+
+BOOST_AUTO_TEST_CASE(PORV_threads) {
+    Opm::Deck deck = createLargeMULTREGPDeck();
+    Opm::TableManager tm( deck );
+    Opm::EclipseGrid grid( deck );
+    Opm::Eclipse3DProperties props( deck, tm, grid );
+    Opm::Eclipse3DProperties props4( deck, tm, grid, 4 );
+
+    const auto& porv = props.getDoubleGridProperty("PORV").getData();
+    BOOST_CHECK( porv == props4.getDoubleGridProperty("PORV").getData() );
+
+    const auto& multnum = props.getIntGridProperty("MULTNUM").getData();
+    const auto& fluxnum = props.getIntGridProperty("FLUXNUM").getData();
+    const double cell_volume = 0.25 * 0.5 * 0.125;
+    for (size_t g = 0; g < porv.size(); g++) {
+        double expected = g < 1600 ? 77 : (0.05 + 0.01 * (g % 17)) * cell_volume * (g < 8000 ? 0.5 : 0.75);
+        if (g >= 4000 && g < 8000)
+            expected *= 3;
+
+        /* the records in deck order; no cell has MULTNUM 7 */
+        if (fluxnum[g] == 1) expected *= 10.0;
+        if (multnum[g] == 2) expected *= 3.0;
+        if (fluxnum[g] == 5) expected *= 0.25;
+        if (fluxnum[g] == 6) expected *= 1.5;
+        if (multnum[g] == 4) expected *= 0.1;
+
+        BOOST_CHECK_CLOSE( expected , porv[g] , 1e-10 );
+    }
+}
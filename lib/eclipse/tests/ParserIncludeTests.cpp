@@ -19,7 +19,9 @@
 
 
 #define BOOST_TEST_MODULE ParserTests
-#include <boost/filesystem/path.hpp>
+#include <fstream>
+
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include <opm/parser/eclipse/Parser/Parser.hpp>
@@ -126,3 +128,106 @@ BOOST_AUTO_TEST_CASE(ParserKeyword_includeWrongCase) {
 #endif
 }
 
+
+
+static void check_equal_decks( const Opm::Deck& serial, const Opm::Deck& parallel ) {
+    BOOST_REQUIRE_EQUAL( serial.size(), parallel.size() );
+    for( size_t i = 0; i < serial.size(); ++i ) {
+        const auto& kw1 = serial.getKeyword( i );
+        const auto& kw2 = parallel.getKeyword( i );
+        BOOST_CHECK_EQUAL( kw1.name(), kw2.name() );
+        BOOST_CHECK_EQUAL( kw1.getFileName(), kw2.getFileName() );
+        BOOST_CHECK_EQUAL( kw1.getLineNumber(), kw2.getLineNumber() );
+        BOOST_CHECK( kw1.equal( kw2, true, false ) );
+    }
+
+    const auto& msg1 = serial.getMessageContainer();
+    const auto& msg2 = parallel.getMessageContainer();
+    BOOST_REQUIRE_EQUAL( msg1.size(), msg2.size() );
+    for( auto it1 = msg1.begin(), it2 = msg2.begin(); it1 != msg1.end(); ++it1, ++it2 )
+        BOOST_CHECK_EQUAL( it1->message, it2->message );
+}
+
+BOOST_AUTO_TEST_CASE(ParseIncludesInParallel_data) {
+    Opm::Parser parser;
+    Opm::ParseContext parseContext;
+
+    for( const auto& name : { "includeValid.data",
+                              "PATHSInInclude.data",
+                              "PATHSWithBackslashes.data" } ) {
+        const auto path = prefix() + name;
+        check_equal_decks( parser.parseFile( path, parseContext ),
+                           parser.parseFile( path, parseContext, 4 ) );
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ParseIncludesInParallel) {
+    using namespace boost::filesystem;
+
+    path root = temp_directory_path() / unique_path("%%%%-%%%%");
+    create_directories( root / "include" );
+
+    const auto write = [&root]( const std::string& name, const std::string& content ) {
+        std::ofstream( ( root / name ).string() ) << content;
+    };
+
+    write( "CASE.DATA",
+           "RUNSPEC\n"
+           "DIMENS\n 2 2 1 /\n"
+           "EQLDIMS\n 2 /\n"
+           "PATHS\n 'INC' 'include' /\n/\n"
+           "GRID\n"
+           "INCLUDE\n '$INC/grid.inc' /\n"
+           "INCLUDE\n 'include/nested.inc' /\n"
+           "PROPS\n"
+           "INCLUDE\n '$INC/eqlnum.inc' /\n"
+           "INCLUDE\n 'include/unknown.inc' /\n"
+           "INCLUDE\n 'include/missing.inc' /\n"
+           "INCLUDE\n '$INC/grid.inc' /\n"
+           "SOLUTION\n" );
+
+    /* independent, can be parsed by a worker */
+    write( "include/grid.inc",
+           "PORO\n 4*0.25 /\n"
+           "-- comment\n"
+           "PERMX\n 1 2 3 4 /\n" );
+
+    write( "include/nested.inc",
+           "INCLUDE\n 'include/ntg.inc' /\n"
+           "MULTPV\n 4*1.0 /\n" );
+
+    write( "include/ntg.inc",
+           "NTG\n 4*0.5 /\n"
+           "ENDINC\n"
+           "NTG\n 4*0.0 /\n" );
+
+    /* EQUIL is sized by EQLDIMS in the root file, parsed serially */
+    write( "include/eqlnum.inc",
+           "EQUIL\n 2000 200 2100 0 1000 0 /\n 2000 200 2100 0 1000 0 /\n" );
+
+    /* ends with an unknown keyword followed by text in the root file */
+    write( "include/unknown.inc",
+           "SWAT\n 4*0.2 /\n"
+           "FOOBAR\n" );
+
+    Opm::Parser parser;
+    Opm::ParseContext parseContext;
+    parseContext.update( Opm::ParseContext::PARSE_UNKNOWN_KEYWORD, Opm::InputError::IGNORE );
+    parseContext.update( Opm::ParseContext::PARSE_MISSING_INCLUDE, Opm::InputError::WARN );
+
+    const auto data = ( root / "CASE.DATA" ).string();
+    const auto serial = parser.parseFile( data, parseContext );
+
+    BOOST_CHECK_EQUAL( 2U, serial.count( "PORO" ) );
+    BOOST_CHECK_EQUAL( 1U, serial.count( "NTG" ) );
+    BOOST_CHECK( serial.hasKeyword( "EQUIL" ) );
+    BOOST_CHECK( serial.hasKeyword( "SOLUTION" ) );
+
+    for( size_t threads : { 1, 2, 8 } )
+        check_equal_decks( serial, parser.parseFile( data, parseContext, threads ) );
+
+    parseContext.update( Opm::ParseContext::PARSE_MISSING_INCLUDE, Opm::InputError::THROW_EXCEPTION );
+    BOOST_CHECK_THROW( parser.parseFile( data, parseContext, 4 ), std::invalid_argument );
+
+    remove_all( root );
+}
@@ -18,12 +18,20 @@
  */
 
 #define BOOST_TEST_MODULE ParserTests
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <thread>
+
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include <opm/json/JsonObject.hpp>
 
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
+#include <opm/parser/eclipse/Parser/DeckNameHash.hpp>
+#include <opm/parser/eclipse/Parser/KeywordVisitor.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
@@ -292,6 +300,105 @@ BOOST_AUTO_TEST_CASE(WildCardTest) {
 }
 
 
+BOOST_AUTO_TEST_CASE(DeckNameHashIsPerfect) {
+    Parser parser;
+    const auto names = parser.getAllDeckNames();
+    const auto table = DeckNameHash::build( names );
+    const DeckNameHash hash( table );
+
+    std::set< int > slots;
+    for( const auto& name : names ) {
+        if( name.size() > 8 ) {
+            BOOST_CHECK_EQUAL( -1, hash.slot( name ) );
+            continue;
+        }
+
+        const auto slot = hash.slot( name );
+        BOOST_CHECK( slot >= 0 );
+        BOOST_CHECK( slots.insert( slot ).second );
+    }
+
+    BOOST_CHECK( slots.size() <= hash.size() );
+    BOOST_CHECK_EQUAL( -1, hash.slot( "NOSUCHKW" ) );
+    BOOST_CHECK_EQUAL( -1, hash.slot( "" ) );
+    BOOST_CHECK_EQUAL( -1, hash.slot( "TOOLONGNAME" ) );
+
+    BOOST_CHECK_EQUAL( 0U, DeckNameHash::pack( "" ) );
+    BOOST_CHECK_EQUAL( 0U, DeckNameHash::pack( "TOOLONGNAME" ) );
+    BOOST_CHECK( DeckNameHash::pack( "WELSPECS" ) != DeckNameHash::pack( "WELSPECZ" ) );
+}
+
+BOOST_AUTO_TEST_CASE(WildCardPrefixes) {
+    Parser parser;
+
+    /* every wildcard keyword must still be found through the prefix trie */
+    for( const auto& name : { "FUWCT", "FTPRSEA", "WUWCT", "WBHWC1", "WOFWC12",
+                              "GUOPR", "RUWCT", "ROPR_1", "RIP_AB", "BUPR",
+                              "CUWCT", "CTFRSEA", "AAQR", "ANQR", "FIPOWG",
+                              "TNUMFSA", "TVDPA" } ) {
+        BOOST_CHECK_MESSAGE( parser.isRecognizedKeyword( name ), name );
+    }
+
+    for( const auto& name : { "WBHWC", "RXPR_1", "TNUMX", "ANQ", "AA" } )
+        BOOST_CHECK_MESSAGE( !parser.isRecognizedKeyword( name ), name );
+
+    /* keywords added at runtime, also over the built-in names */
+    std::unique_ptr< ParserKeyword > wildcard( new ParserKeyword( "ABC_PROBE" ) );
+    wildcard->setMatchRegex( "(XA|XB)Y?.+|Q+Z" );
+    const auto* wildcard_ptr = wildcard.get();
+    parser.addParserKeyword( std::move( wildcard ) );
+
+    BOOST_CHECK_EQUAL( wildcard_ptr, parser.getParserKeywordFromDeckName( "XAYZ" ) );
+    BOOST_CHECK_EQUAL( wildcard_ptr, parser.getParserKeywordFromDeckName( "XBZ" ) );
+    BOOST_CHECK_EQUAL( wildcard_ptr, parser.getParserKeywordFromDeckName( "QQZ" ) );
+    BOOST_CHECK( !parser.isRecognizedKeyword( "XCZ" ) );
+
+    std::unique_ptr< ParserKeyword > welspecs( new ParserKeyword( "WELSPECS" ) );
+    const auto* welspecs_ptr = welspecs.get();
+    parser.addParserKeyword( std::move( welspecs ) );
+    BOOST_CHECK_EQUAL( welspecs_ptr, parser.getParserKeywordFromDeckName( "WELSPECS" ) );
+
+    std::unique_ptr< ParserKeyword > added( new ParserKeyword( "NOSUCHKW" ) );
+    const auto* added_ptr = added.get();
+    BOOST_CHECK( !parser.hasKeyword( "NOSUCHKW" ) );
+    parser.addParserKeyword( std::move( added ) );
+    BOOST_CHECK( parser.hasKeyword( "NOSUCHKW" ) );
+    BOOST_CHECK_EQUAL( added_ptr, parser.getParserKeywordFromDeckName( "NOSUCHKW" ) );
+}
+
+
+BOOST_AUTO_TEST_CASE(DefaultKeywordsCreatedOnLookup) {
+    Parser parser;
+    /* the deck names come first and sorted, followed by the wildcard keywords */
+    const auto all = parser.getAllDeckNames();
+    const std::vector< std::string > names( all.begin(), all.begin() + parser.size() );
+    BOOST_CHECK( std::is_sorted( names.begin(), names.end() ) );
+    BOOST_CHECK( std::find( names.begin(), names.end(), "EQLDIMS" ) != names.end() );
+
+    /* concurrent first lookups all end up with the same keyword */
+    std::vector< std::vector< const ParserKeyword* > > found( 4 );
+    std::vector< std::thread > threads;
+    for( auto& keywords : found ) {
+        threads.emplace_back( [&parser, &names, &keywords] {
+            for( const auto& name : names )
+                keywords.push_back( parser.getParserKeywordFromDeckName( name ) );
+        } );
+    }
+
+    for( auto& thread : threads ) thread.join();
+
+    for( size_t i = 0; i < names.size(); ++i ) {
+        BOOST_CHECK( found[ 0 ][ i ] != nullptr );
+        BOOST_CHECK( found[ 0 ][ i ]->matches( names[ i ] ) );
+        for( const auto& keywords : found )
+            BOOST_CHECK_EQUAL( found[ 0 ][ i ], keywords[ i ] );
+    }
+
+    BOOST_CHECK_EQUAL( all.size(), parser.getAllDeckNames().size() );
+    BOOST_CHECK_EQUAL( "EQLDIMS", parser.getKeyword( "EQLDIMS" )->getName() );
+}
+
+
 BOOST_AUTO_TEST_CASE( quoted_comments ) {
     BOOST_CHECK_EQUAL( Parser::stripComments( "ABC" ) , "ABC");
     BOOST_CHECK_EQUAL( Parser::stripComments( "--ABC") , "");
@@ -785,6 +892,45 @@ BOOST_AUTO_TEST_CASE(Scan_RawRecordErrorInRawData_ExceptionThrown) {
     BOOST_CHECK_THROW(itemInt.scan(rawRecord5), std::invalid_argument);
 }
 
+BOOST_AUTO_TEST_CASE(Scan_All_BulkEqualsTokenwise) {
+    ParserItem itemDouble( "ITEM", ParserItem::item_size::ALL, 1.0 );
+    ParserItem itemInt( "ITEM", ParserItem::item_size::ALL );
+    itemInt.setType( int() );
+
+    const std::string doubles = "1 -2.5 +0.125\n3.e2 .5E-3 1.5d3 2D-1, 4*0.1 2* 3*-7e+1\n"
+                                "0.12345678901234567890 1e-30 1E300 12345678901234567 -0.0";
+    const std::string ints = "1 -2 +3\n 4*7 2* 123456789 -1234567890 3*0";
+
+    RawRecord bulkDouble( doubles );
+    RawRecord tokensDouble( doubles );
+    BOOST_CHECK_EQUAL( 15U, tokensDouble.size() );
+
+    const auto bulkDoubleItem = itemDouble.scan( bulkDouble );
+    const auto tokensDoubleItem = itemDouble.scan( tokensDouble );
+    BOOST_CHECK_EQUAL( 0U, bulkDouble.size() );
+    BOOST_CHECK_EQUAL( 21U, bulkDoubleItem.size() );
+    BOOST_CHECK( bulkDoubleItem.equal( tokensDoubleItem, true, false ) );
+    BOOST_CHECK_EQUAL( 0.1, bulkDoubleItem.get< double >( 7 ) );
+    BOOST_CHECK( bulkDoubleItem.defaultApplied( 11 ) );
+    BOOST_CHECK_EQUAL( -70.0, bulkDoubleItem.get< double >( 14 ) );
+
+    RawRecord bulkInt( ints );
+    RawRecord tokensInt( ints );
+    BOOST_CHECK_EQUAL( 8U, tokensInt.size() );
+
+    const auto bulkIntItem = itemInt.scan( bulkInt );
+    const auto tokensIntItem = itemInt.scan( tokensInt );
+    BOOST_CHECK_EQUAL( 14U, bulkIntItem.size() );
+    BOOST_CHECK( bulkIntItem.equal( tokensIntItem, true, false ) );
+    BOOST_CHECK_EQUAL( -1234567890, bulkIntItem.get< int >( 10 ) );
+
+    RawRecord zeroRepeat( "1 0*2" );
+    BOOST_CHECK_THROW( itemInt.scan( zeroRepeat ), std::invalid_argument );
+
+    RawRecord malformed( "1.0 2.0x" );
+    BOOST_CHECK_THROW( itemDouble.scan( malformed ), std::invalid_argument );
+}
+
 /*********************String************************'*/
 /*****************************************************************/
 /*</json>*/
@@ -1873,3 +2019,91 @@ AQUTAB
   BOOST_CHECK_EQUAL( 1, aqutab.size());
 }
 
+
+namespace {
+
+struct CollectKeywords : public KeywordVisitor {
+    bool section( const std::string& name ) override {
+        return skipped_sections.count( name ) == 0;
+    }
+
+    bool keyword( const std::string& name ) override {
+        return skipped_keywords.count( name ) == 0;
+    }
+
+    void visit( DeckKeyword&& kw ) override {
+        keywords.push_back( std::move( kw ) );
+    }
+
+    std::set< std::string > skipped_sections;
+    std::set< std::string > skipped_keywords;
+    std::vector< DeckKeyword > keywords;
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(ParseFileWithVisitor) {
+    const auto* deck_string = R"(
+RUNSPEC
+DIMENS
+ 2 2 1 /
+TABDIMS
+ /
+FIELD
+GRID
+PERMX
+ 1 2* 4 /
+PORO
+ 4*0.25 /
+PROPS
+DENSITY
+ 50 1* 0.05 /
+FOOBAR
+SCHEDULE
+WELSPECS
+ 'W1' 'G1' 1 1 1* 'OIL' /
+/
+)";
+
+    using namespace boost::filesystem;
+    const auto data = temp_directory_path() / unique_path( "%%%%-%%%%.DATA" );
+    std::ofstream( data.string() ) << deck_string;
+
+    ParseContext parseContext;
+    parseContext.update( ParseContext::PARSE_UNKNOWN_KEYWORD, InputError::IGNORE );
+
+    Parser parser;
+    const auto deck = parser.parseFile( data.string(), parseContext );
+
+    CollectKeywords all;
+    const auto messages = parser.parseFile( data.string(), parseContext, all );
+    BOOST_CHECK_EQUAL( deck.getMessageContainer().size(), messages.size() );
+    BOOST_REQUIRE_EQUAL( deck.size(), all.keywords.size() );
+    for( size_t i = 0; i < deck.size(); ++i ) {
+        const auto& kw = deck.getKeyword( i );
+        BOOST_CHECK_EQUAL( kw.name(), all.keywords[ i ].name() );
+        BOOST_CHECK_EQUAL( kw.getLineNumber(), all.keywords[ i ].getLineNumber() );
+        BOOST_CHECK( kw.equal( all.keywords[ i ], true, true ) );
+    }
+
+    /* converted from field units, which are only known when RUNSPEC ends */
+    const auto& density = deck.getKeyword( "DENSITY" ).getRecord( 0 ).getItem( 0 );
+    const auto& streamed = all.keywords[ 8 ].getRecord( 0 ).getItem( 0 );
+    BOOST_CHECK_EQUAL( "DENSITY", all.keywords[ 8 ].name() );
+    BOOST_CHECK_EQUAL( density.getSIDouble( 0 ), streamed.getSIDouble( 0 ) );
+    BOOST_CHECK( density.getSIDouble( 0 ) != density.get< double >( 0 ) );
+
+    /* TABDIMS is needed to parse DENSITY even when RUNSPEC is skipped */
+    CollectKeywords some;
+    some.skipped_sections = { "RUNSPEC", "GRID", "SCHEDULE" };
+    some.skipped_keywords = { "FOOBAR" };
+    parser.parseFile( data.string(), parseContext, some );
+
+    BOOST_REQUIRE_EQUAL( 2U, some.keywords.size() );
+    BOOST_CHECK_EQUAL( "PROPS", some.keywords[ 0 ].name() );
+    BOOST_CHECK_EQUAL( "DENSITY", some.keywords[ 1 ].name() );
+    BOOST_CHECK_EQUAL( density.getSIDouble( 0 ),
+                       some.keywords[ 1 ].getRecord( 0 ).getItem( 0 ).getSIDouble( 0 ) );
+
+    remove( data );
+}
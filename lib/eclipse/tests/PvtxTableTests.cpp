@@ -29,6 +29,7 @@
 
 // generic table classes
 #include <opm/parser/eclipse/EclipseState/Tables/SimpleTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/PvtxEvaluator.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/PvtxTable.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
 
@@ -43,8 +44,11 @@
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/filesystem.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 #include <iostream>
+#include <thread>
 
 using namespace Opm;
 
@@ -222,3 +226,139 @@ BOOST_AUTO_TEST_CASE( PVTWTable ) {
     BOOST_CHECK_CLOSE( 0.56341,  rec2.viscosity * 1e3, 1e-5 );
     BOOST_CHECK_CLOSE( 1.20e-07, rec2.viscosibility * 1e5, 1e-5 );
 }
+
+
+namespace {
+
+/*
+  The nodes, points outside them, and two points inside every interval
+  between distinct nodes, together with the width of that interval.
+*/
+std::vector< std::pair< double, double > > arguments( std::vector< double > nodes ) {
+    std::sort( nodes.begin(), nodes.end() );
+    nodes.erase( std::unique( nodes.begin(), nodes.end() ), nodes.end() );
+
+    const double span = nodes.back() - nodes.front();
+    std::vector< std::pair< double, double > > args = {
+        { nodes.front() - 0.5 * span - 1, 0 },
+        { nodes.back() + 0.5 * span + 1, 0 }
+    };
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        args.emplace_back( nodes[i], 0 );
+        if (i + 1 < nodes.size()) {
+            const double width = nodes[i + 1] - nodes[i];
+            args.emplace_back( nodes[i] + 0.37 * width, width );
+            args.emplace_back( nodes[i] + 0.81 * width, width );
+        }
+    }
+
+    return args;
+}
+
+void checkEvaluator( const PvtxTable& table, const std::vector< std::string >& columns ) {
+    const PvtxEvaluator evaluator( table );
+
+    std::vector< double > outerNodes, innerNodes;
+    for (size_t index = 0; index < table.size(); ++index)
+        outerNodes.push_back( table.getArgValue( index ) );
+    for (const auto& underSaturatedTable : table) {
+        const auto inner = underSaturatedTable.getColumn( 0 ).vectorCopy();
+        innerNodes.insert( innerNodes.end(), inner.begin(), inner.end() );
+    }
+
+    std::vector< double > outerArgs, innerArgs;
+    for (const auto& outer : arguments( outerNodes )) {
+        for (const auto& inner : arguments( innerNodes )) {
+            outerArgs.push_back( outer.first );
+            innerArgs.push_back( inner.first );
+        }
+    }
+
+    for (const auto& name : columns) {
+        const auto column = evaluator.column( name );
+
+        std::vector< double > dOuter, dInner;
+        const auto values = evaluator.evaluate( column, outerArgs, innerArgs, &dOuter, &dInner );
+        BOOST_CHECK( values == evaluator.evaluate( column, outerArgs, innerArgs ) );
+
+        for (size_t i = 0; i < values.size(); ++i) {
+            const double expected = table.evaluate( name, outerArgs[i], innerArgs[i] );
+            BOOST_CHECK_CLOSE( values[i], expected, 1e-10 );
+            BOOST_CHECK_EQUAL( values[i], evaluator.evaluate( column, outerArgs[i], innerArgs[i] ) );
+        }
+
+        /* the derivatives are compared with central differences away from the nodes */
+        size_t i = 0;
+        for (const auto& outer : arguments( outerNodes )) {
+            for (const auto& inner : arguments( innerNodes )) {
+                if (outer.second > 0) {
+                    const double h = 1e-3 * outer.second;
+                    const double fd = (table.evaluate( name, outer.first + h, inner.first ) -
+                                       table.evaluate( name, outer.first - h, inner.first )) / (2 * h);
+                    BOOST_CHECK_SMALL( (dOuter[i] - fd) * h, 1e-9 * std::abs( values[i] ) );
+                }
+
+                if (inner.second > 0) {
+                    const double h = 1e-3 * inner.second;
+                    const double fd = (table.evaluate( name, outer.first, inner.first + h ) -
+                                       table.evaluate( name, outer.first, inner.first - h )) / (2 * h);
+                    BOOST_CHECK_SMALL( (dInner[i] - fd) * h, 1e-9 * std::abs( values[i] ) );
+                }
+
+                ++i;
+            }
+        }
+    }
+
+    BOOST_CHECK( std::isnan( evaluator.evaluate( 0, std::nan(""), innerArgs[0] ) ) );
+    BOOST_CHECK_THROW( evaluator.column( "NO_SUCH_COLUMN" ), std::invalid_argument );
+    BOOST_CHECK_THROW( evaluator.evaluate( columns.size(), outerArgs[0], innerArgs[0] ), std::invalid_argument );
+    BOOST_CHECK_THROW( evaluator.evaluate( 0, outerArgs, std::vector< double >( 1 ) ), std::invalid_argument );
+}
+
+}
+
+
+BOOST_AUTO_TEST_CASE( PvtxEvaluatorTest ) {
+    Parser parser;
+    boost::filesystem::path deckFile(prefix() + "TABLES/PVTX1.DATA");
+    ParseContext parseContext;
+    auto deck =  parser.parseFile(deckFile.string(), parseContext);
+    Opm::TableManager tables(deck);
+
+    checkEvaluator( tables.getPvtoTables()[0], { "BO", "MU" } );
+    checkEvaluator( tables.getPvtgTables()[0], { "BG", "MUG" } );
+}
+
+
+BOOST_AUTO_TEST_CASE( PvtxEvaluatorConcurrent ) {
+    Parser parser;
+    boost::filesystem::path deckFile(prefix() + "TABLES/PVTX1.DATA");
+    ParseContext parseContext;
+    auto deck =  parser.parseFile(deckFile.string(), parseContext);
+    Opm::TableManager tables(deck);
+
+    const auto& pvtoTable = tables.getPvtoTables()[0];
+    const PvtxEvaluator evaluator( pvtoTable );
+    const auto column = evaluator.column( "MU" );
+
+    std::vector< double > rs, p;
+    for (int i = 0; i < 10000; ++i) {
+        rs.push_back( 18 + 0.0013 * i );
+        p.push_back( 4.0e6 + 1.7e3 * i );
+    }
+
+    const auto expected = evaluator.evaluate( column, rs, p );
+
+    std::vector< std::vector< double > > results( 4 );
+    std::vector< std::thread > threads;
+    for (auto& result : results)
+        threads.emplace_back( [&]() { result = evaluator.evaluate( column, rs, p ); } );
+
+    for (auto& thread : threads)
+        thread.join();
+
+    for (const auto& result : results)
+        BOOST_CHECK( result == expected );
+}
@@ -231,6 +231,35 @@ BOOST_AUTO_TEST_CASE(Rawrecord_PushFront_OK) {
     BOOST_CHECK_EQUAL("String2", record.getItem(1));
 }
 
+BOOST_AUTO_TEST_CASE(Rawrecord_PopPrepend_OK) {
+    Opm::RawRecord record(" 'NODIR '  'REVERS'  1  20  ");
+
+    BOOST_CHECK_EQUAL("'NODIR '", record.pop_front());
+    BOOST_CHECK_EQUAL("'REVERS'", record.pop_front());
+    BOOST_CHECK_EQUAL(2U, record.size());
+
+    record.prepend( 3, "2.5" );
+    record.prepend( 2, "7" );
+    BOOST_CHECK_EQUAL(7U, record.size());
+    BOOST_CHECK_EQUAL("7", record.getItem(1));
+    BOOST_CHECK_EQUAL("2.5", record.getItem(2));
+    BOOST_CHECK_EQUAL("2.5", record.getItem(4));
+    BOOST_CHECK_EQUAL("1", record.getItem(5));
+    BOOST_CHECK_EQUAL("20", record.getItem(6));
+    BOOST_CHECK_THROW(record.getItem(7), std::out_of_range);
+
+    BOOST_CHECK_EQUAL("7", record.pop_front());
+    BOOST_CHECK_EQUAL("7", record.pop_front());
+    BOOST_CHECK_EQUAL("2.5", record.pop_front());
+    record.prepend( 1, "3" );
+    BOOST_CHECK_EQUAL("3", record.pop_front());
+    BOOST_CHECK_EQUAL("2.5", record.pop_front());
+    BOOST_CHECK_EQUAL("2.5", record.pop_front());
+    BOOST_CHECK_EQUAL("1", record.pop_front());
+    BOOST_CHECK_EQUAL("20", record.pop_front());
+    BOOST_CHECK_EQUAL(0U, record.size());
+}
+
 BOOST_AUTO_TEST_CASE(Rawrecord_size_OK) {
     Opm::RawRecord record(" 'NODIR '  'REVERS'  1  20  ");
 
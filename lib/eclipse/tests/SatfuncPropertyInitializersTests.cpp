@@ -19,6 +19,7 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <sstream>
 #include <boost/filesystem.hpp>
 
 #define BOOST_TEST_MODULE SatfuncPropertyInitializersTests
@@ -27,7 +28,9 @@
 
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/SatfuncPropertyInitializers.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
@@ -152,3 +155,83 @@ BOOST_AUTO_TEST_CASE(SaturationFunctionFamilyTests) {
     Opm::Eclipse3DProperties propMix( deckMix, tmMix, gridMix );
     BOOST_CHECK_THROW(propMix.getDoubleGridProperty("SGCR") , std::invalid_argument);
 }
+
+BOOST_AUTO_TEST_CASE(BatchedEndpointScaling) {
+    std::ostringstream deckData;
+    deckData << "RUNSPEC\n"
+             << "OIL\n"
+             << "GAS\n"
+             << "WATER\n"
+             << "DIMENS\n"
+             << " 30 30 10 /\n"
+             << "TABDIMS\n"
+             << "2 /\n"
+             << "ENDSCALE\n"
+             << "2* 2 /\n"
+             << "GRID\n"
+             << "DXV\n"
+             << "30*10 /\n"
+             << "DYV\n"
+             << "30*10 /\n"
+             << "DZV\n"
+             << "10*500 /\n"
+             << "TOPS\n"
+             << "900*2000 /\n"
+             << "PROPS\n"
+             << "SWOF\n"
+             << "0.1 0.0 1.0 0.0\n"
+             << "0.2 0.1 0.6 0.0\n"
+             << "1.0 0.9 0.0 0.0 /\n"
+             << "0.2 0.0 1.0 0.0\n"
+             << "0.4 0.2 0.5 0.0\n"
+             << "1.0 0.8 0.0 0.0 /\n"
+             << "SGOF\n"
+             << "0.0 0.0 1.0 0.0\n"
+             << "0.3 0.2 0.4 0.0\n"
+             << "0.9 0.9 0.0 0.0 /\n"
+             << "0.05 0.0 1.0 0.0\n"
+             << "0.3  0.1 0.5 0.0\n"
+             << "0.8  1.0 0.0 0.0 /\n"
+             << "ENPTVD\n"
+             << "3000.0 0.20 0.20 1.0 0.0 0.04 1.0 0.18 0.22\n"
+             << "6000.0 0.22 0.22 1.0 0.0 0.04 1.0 0.18 0.22 /\n"
+             << "3000.0 0.25 0.30 0.9 0.0 0.05 1.0 0.16 0.20\n"
+             << "6000.0 0.27 0.10 0.8 0.0 0.05 1.0 0.16 0.20 /\n"
+             << "REGIONS\n"
+             << "SATNUM\n";
+    for (int g = 0; g < 9000; g++)
+        deckData << 1 + g % 2 << " ";
+    deckData << "/\n"
+             << "ENDNUM\n";
+    for (int g = 0; g < 9000; g++)
+        deckData << 1 + (g / 7) % 2 << " ";
+    deckData << "/\n";
+
+    Parser parser;
+    const auto deck = parser.parseString( deckData.str(), ParseContext() );
+    TableManager tables( deck );
+    EclipseGrid grid( deck );
+    Eclipse3DProperties props( deck, tables, grid );
+
+    const std::vector< std::string > keywords = {
+        "SWL", "SWCR", "SWU", "SGL", "SGCR", "SOWCR", "ISWL", "ISWU"
+    };
+
+    const auto& intProps = props.getIntProperties();
+    const auto serial = endpointScaling( keywords, &tables, &grid, &intProps );
+    const auto concurrent = endpointScaling( keywords, &tables, &grid, &intProps, 4 );
+
+    BOOST_CHECK_EQUAL( keywords.size(), concurrent.size() );
+    for (size_t k = 0; k < keywords.size(); k++) {
+        BOOST_CHECK( serial[ k ] == concurrent[ k ] );
+        BOOST_CHECK( concurrent[ k ] == props.getDoubleGridProperty( keywords[ k ] ).getData() );
+    }
+
+    /* the top layer is above the depth tables, and uses their first row */
+    BOOST_CHECK_EQUAL( 0.20, concurrent[ 0 ][ 0 ] );
+    BOOST_CHECK_EQUAL( 0.25, concurrent[ 0 ][ 7 ] );
+    BOOST_CHECK_CLOSE( 0.25 + 0.02 * 1750 / 3000, concurrent[ 0 ][ 7 + 900 * 5 ], 1e-8 );
+
+    BOOST_CHECK_THROW( endpointScaling( { "SWL", "XYZ" }, &tables, &grid, &intProps ),
+                       std::invalid_argument );
+}
@@ -451,6 +451,54 @@ BOOST_AUTO_TEST_CASE(WellsIteratorWithRegex_HasWells_WellsReturned) {
     BOOST_CHECK_EQUAL(1U, wells.size());
 }
 
+BOOST_AUTO_TEST_CASE(WellsMatchingPatternsInDefinitionOrder) {
+    EclipseGrid grid(10,10,10);
+    Opm::Parser parser;
+    std::string input =
+            "START             -- 0 \n"
+            "10 MAI 2007 / \n"
+            "SCHEDULE\n"
+            "WELSPECS\n"
+            "     \'WB_2\'   \'OP\'   1   1  3.33  \'OIL\'  7* /   \n"
+            "     \'PROD\'   \'OP\'   1   2  3.33  \'OIL\'  7* /   \n"
+            "     \'WA_1\'   \'OP\'   1   3  3.33  \'OIL\'  7* /   \n"
+            "     \'W\'      \'OP\'   1   4  3.33  \'OIL\'  7* /   \n"
+            "/\n"
+            "DATES             -- 1\n"
+            " 10  \'JUN\'  2007 / \n"
+            "/\n"
+            "WELSPECS\n"
+            "     \'WB_1\'   \'OP\'   2   1  3.33  \'OIL\'  7* /   \n"
+            "     \'WA_10\'  \'OP\'   2   2  3.33  \'OIL\'  7* /   \n"
+            "     \'X\'      \'OP\'   2   3  3.33  \'OIL\'  7* /   \n"
+            "     \'PROD2\'  \'OP\'   2   4  3.33  \'OIL\'  7* /   \n"
+            "/\n";
+
+    auto deck = parser.parseString(input, ParseContext());
+    TableManager table ( deck );
+    Eclipse3DProperties eclipseProperties ( deck , table, grid);
+    Schedule schedule(deck, grid , eclipseProperties, Phases(true, true, true) , ParseContext());
+
+    const auto all_wells = schedule.getWells();
+    BOOST_CHECK_EQUAL(8U, all_wells.size());
+
+    for (const std::string pattern : { "*", "W*", "WA_1*", "W?_1*", "W[AB]_2*", "PROD*", "X*", "Y*" }) {
+        std::vector< const Well* > expected;
+        for (const auto* well : all_wells) {
+            if (Well::wellNameInWellNamePattern(well->name(), pattern))
+                expected.push_back(well);
+        }
+
+        const auto wells = schedule.getWellsMatching(pattern);
+        BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), wells.begin(), wells.end());
+    }
+
+    BOOST_CHECK_EQUAL(2U, schedule.getWellsMatching("WA_1*").size());
+    BOOST_CHECK_EQUAL(1U, schedule.getWellsMatching("W").size());
+    BOOST_CHECK_EQUAL(0U, schedule.getWellsMatching("*1*").size());
+    BOOST_CHECK_EQUAL(0U, schedule.getWellsMatching("").size());
+}
+
 BOOST_AUTO_TEST_CASE(ReturnNumWellsTimestep) {
     EclipseGrid grid(10,10,10);
     auto deck = createDeckWithWells();
@@ -85,3 +85,29 @@ BOOST_AUTO_TEST_CASE( CreateTest ) {
     }
 }
 
+
+
+BOOST_AUTO_TEST_CASE( BatchEvaluate ) {
+    TableSchema schema;
+    schema.addColumn( ColumnSchema("X" , Table::STRICTLY_INCREASING , Table::DEFAULT_NONE) );
+    schema.addColumn( ColumnSchema("Y" , Table::RANDOM , Table::DEFAULT_NONE) );
+
+    SimpleTable table(schema);
+    table.addRow( {0, 10} );
+    table.addRow( {1, 30} );
+    table.addRow( {3, 20} );
+
+    const std::vector<double> xPos = { -1, 0, 0.5, 1, 2, 3, 4 };
+    const auto byName = table.evaluate( "Y" , xPos );
+    const auto byIndex = table.evaluate( 1 , xPos );
+
+    BOOST_CHECK_EQUAL( byName.size() , xPos.size() );
+    for (size_t i = 0; i < xPos.size(); ++i) {
+        BOOST_CHECK_EQUAL( byName[i] , table.evaluate( "Y" , xPos[i] ) );
+        BOOST_CHECK_EQUAL( byIndex[i] , byName[i] );
+    }
+
+    BOOST_CHECK_CLOSE( byName[2] , 20 , 1e-8 );
+    BOOST_CHECK_CLOSE( byName[4] , 25 , 1e-8 );
+    BOOST_CHECK_THROW( table.evaluate( "Z" , xPos ) , std::invalid_argument );
+}
@@ -19,6 +19,9 @@
 
 #define BOOST_TEST_MODULE TableColumnTests
 
+#include <algorithm>
+#include <cmath>
+
 #include <boost/test/unit_test.hpp>
 
 
@@ -171,6 +174,15 @@ BOOST_AUTO_TEST_CASE( Test_MIN_MAX) {
     column.updateValue( 3 , 67 );
     BOOST_CHECK_EQUAL( 1 , column.min() );
     BOOST_CHECK_EQUAL( 100 , column.max() );
+
+    column.updateValue( 2 , 200 );
+    BOOST_CHECK_EQUAL( 200 , column.max() );
+
+    column.updateValue( 2 , 50 );
+    BOOST_CHECK_EQUAL( 100 , column.max() );
+
+    column.updateValue( 0 , 75 );
+    BOOST_CHECK_EQUAL( 50 , column.min() );
 }
 
 BOOST_AUTO_TEST_CASE( Test_IN_RANGE) {
@@ -258,6 +270,12 @@ BOOST_AUTO_TEST_CASE( Test_EVAL_INCREASING ) {
     /* Out of range - constant end-point extrapolation */
     BOOST_CHECK_EQUAL( column.eval( column.lookup( -1 )) , 0 );
     BOOST_CHECK_EQUAL( column.eval( column.lookup(  4 )) , 3 );
+
+    {
+        const auto index = column.lookup( std::nan("") );
+        BOOST_CHECK_EQUAL( index.getIndex1() , 0U );
+        BOOST_CHECK( std::isnan( column.eval( index )));
+    }
 }
 
 
@@ -322,3 +340,62 @@ BOOST_AUTO_TEST_CASE( Test_LINEAR_DEFAULT ) {
     BOOST_CHECK_CLOSE( valueColumn[3] , 1.00 , 1e-6);
     BOOST_CHECK_CLOSE( valueColumn[5] , 0.25 , 1e-6);
 }
+
+
+BOOST_AUTO_TEST_CASE( Test_MIN_MAX_UPDATE ) {
+    ColumnSchema schema("COLUMN" , Table::RANDOM , Table::DEFAULT_NONE);
+    TableColumn column( schema );
+
+    column.addValue( 5 );
+    column.addValue( 1 );
+    column.addValue( 9 );
+    BOOST_CHECK_EQUAL( 1 , column.min() );
+    BOOST_CHECK_EQUAL( 9 , column.max() );
+
+    column.updateValue( 1 , 7 );
+    column.updateValue( 2 , 3 );
+    BOOST_CHECK_EQUAL( 3 , column.min() );
+    BOOST_CHECK_EQUAL( 7 , column.max() );
+
+    TableColumn copy( schema );
+    copy = column;
+    BOOST_CHECK_EQUAL( 3 , copy.min() );
+    BOOST_CHECK_EQUAL( 7 , copy.max() );
+}
+
+
+BOOST_AUTO_TEST_CASE( Test_BATCH_LOOKUP ) {
+    ColumnSchema incSchema("COLUMN" , Table::INCREASING , Table::DEFAULT_NONE);
+    ColumnSchema decSchema("COLUMN" , Table::DECREASING , Table::DEFAULT_NONE);
+    TableColumn increasing( incSchema );
+    TableColumn decreasing( decSchema );
+
+    for (double value : { 0.0, 1.0, 1.0, 2.5, 4.0, 4.0, 7.0 }) {
+        increasing.addValue( value );
+        decreasing.addValue( 7.0 - value );
+    }
+
+    std::vector<double> args;
+    for (int i = -10; i <= 80; ++i)
+        args.push_back( 0.1 * i );
+
+    for (const auto* column : { &increasing, &decreasing }) {
+        const auto indices = column->lookup( args );
+        const auto values = column->eval( indices );
+        BOOST_CHECK_EQUAL( indices.size() , args.size() );
+        BOOST_CHECK_EQUAL( values.size() , args.size() );
+
+        for (size_t i = 0; i < args.size(); ++i) {
+            const auto index = column->lookup( args[i] );
+            BOOST_CHECK_EQUAL( indices[i].getIndex1() , index.getIndex1() );
+            BOOST_CHECK_EQUAL( indices[i].getWeight1() , index.getWeight1() );
+            BOOST_CHECK_EQUAL( values[i] , column->eval( index ) );
+            BOOST_CHECK_CLOSE( values[i] , std::min( std::max( args[i] , 0.0 ) , 7.0 ) , 1e-8 );
+        }
+    }
+
+    ColumnSchema randomSchema("COLUMN" , Table::RANDOM , Table::DEFAULT_NONE);
+    TableColumn random( randomSchema );
+    random.addValue( 1 );
+    BOOST_CHECK_THROW( random.lookup( args ) , std::invalid_argument );
+}
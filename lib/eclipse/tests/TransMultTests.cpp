@@ -17,6 +17,8 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <map>
+#include <memory>
 #include <stdexcept>
 #include <iostream>
 #include <boost/filesystem.hpp>
@@ -30,6 +32,8 @@
 #include <opm/parser/eclipse/EclipseState/Grid/TransMult.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridDims.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/Fault.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/FaultFace.hpp>
 
 BOOST_AUTO_TEST_CASE(Empty) {
     Opm::Eclipse3DProperties props;
@@ -44,3 +48,116 @@ BOOST_AUTO_TEST_CASE(Empty) {
     BOOST_CHECK_EQUAL( transMult.getMultiplier(9,9,9, Opm::FaceDir::YMinus) , 1.0 );
     BOOST_CHECK_EQUAL( transMult.getMultiplier(100 , Opm::FaceDir::ZMinus) , 1.0 );
 }
+
+
+
+BOOST_AUTO_TEST_CASE(CompressedMultiplier) {
+    Opm::Eclipse3DProperties props;
+    Opm::TransMult transMult(Opm::GridDims(3,1,1) ,{} , props);
+
+    Opm::GridPropertySupportedKeywordInfo<double> multxInfo("MULTX" , 1.0 , "1");
+    Opm::GridProperty<double> multx( 3, 1, 1, multxInfo );
+    for (size_t g = 0; g < 3; g++)
+        multx.iset( g, g + 2.0 );
+
+    multx.compress( std::make_shared< std::vector< int > >( std::vector< int >{ 0 , -1 , 1 } ) );
+    transMult.applyMULT( multx, Opm::FaceDir::XPlus );
+
+    /* the inactive cell keeps its multiplier */
+    BOOST_CHECK_EQUAL( transMult.getMultiplier( 0, Opm::FaceDir::XPlus ), 2.0 );
+    BOOST_CHECK_EQUAL( transMult.getMultiplier( 1, Opm::FaceDir::XPlus ), 1.0 );
+    BOOST_CHECK_EQUAL( transMult.getMultiplier( 2, Opm::FaceDir::XPlus ), 4.0 );
+}
+
+BOOST_AUTO_TEST_CASE(DenseAndFaultMultipliers) {
+    const size_t nx = 4, ny = 3, nz = 2;
+    Opm::Eclipse3DProperties props;
+    Opm::TransMult transMult(Opm::GridDims(nx,ny,nz) ,{} , props);
+
+    std::map< Opm::FaceDir::DirEnum, std::vector< double > > expected;
+    for (auto dir : { Opm::FaceDir::XPlus, Opm::FaceDir::XMinus, Opm::FaceDir::YPlus,
+                      Opm::FaceDir::YMinus, Opm::FaceDir::ZPlus, Opm::FaceDir::ZMinus })
+        expected[dir].assign( nx * ny * nz, 1.0 );
+
+    Opm::GridPropertySupportedKeywordInfo<double> multxInfo("MULTX" , 1.0 , "1");
+    Opm::GridProperty<double> multx( nx, ny, nz, multxInfo );
+    for (size_t g = 0; g < nx * ny * nz; g++) {
+        multx.iset( g, 1 + 0.1 * g );
+        expected[Opm::FaceDir::XPlus][g] *= 1 + 0.1 * g;
+    }
+    transMult.applyMULT( multx, Opm::FaceDir::XPlus );
+
+    Opm::Fault fault1("F1");
+    fault1.setTransMult( 0.5 );
+    fault1.addFace( Opm::FaultFace(nx,ny,nz, 1,1, 0,2, 0,1, Opm::FaceDir::XPlus) );
+    fault1.addFace( Opm::FaultFace(nx,ny,nz, 0,3, 2,2, 0,0, Opm::FaceDir::YMinus) );
+
+    Opm::Fault fault2("F2");
+    fault2.setTransMult( 0.25 );
+    fault2.addFace( Opm::FaultFace(nx,ny,nz, 1,1, 1,1, 0,1, Opm::FaceDir::XPlus) );
+    fault2.addFace( Opm::FaultFace(nx,ny,nz, 0,3, 2,2, 0,1, Opm::FaceDir::YMinus) );
+    fault2.addFace( Opm::FaultFace(nx,ny,nz, 0,1, 0,0, 0,0, Opm::FaceDir::ZPlus) );
+
+    for (const auto* fault : { &fault1, &fault2 }) {
+        transMult.applyMULTFLT( *fault );
+        for (const auto& face : *fault)
+            for (auto g : face)
+                expected[face.getDir()][g] *= fault->getTransMult();
+    }
+
+    /* a dense array applied after the faults keeps their multipliers */
+    Opm::GridPropertySupportedKeywordInfo<double> multyInfo("MULTY-" , 1.0 , "1");
+    Opm::GridProperty<double> multy( nx, ny, nz, multyInfo );
+    for (size_t g = 0; g < nx * ny * nz; g++) {
+        multy.iset( g, 2.0 );
+        expected[Opm::FaceDir::YMinus][g] *= 2.0;
+    }
+    transMult.applyMULT( multy, Opm::FaceDir::YMinus );
+
+    for (const auto& dir : expected)
+        for (size_t g = 0; g < nx * ny * nz; g++)
+            BOOST_CHECK_EQUAL( transMult.getMultiplier( g, dir.first ), dir.second[g] );
+
+    const std::vector< std::pair< Opm::FaceDir::DirEnum, Opm::FaceDir::DirEnum > > connections = {
+        { Opm::FaceDir::XPlus, Opm::FaceDir::XMinus },
+        { Opm::FaceDir::YPlus, Opm::FaceDir::YMinus },
+        { Opm::FaceDir::ZPlus, Opm::FaceDir::ZMinus }
+    };
+
+    for (const auto& connection : connections) {
+        const auto multipliers = transMult.getConnectionMultipliers( connection.first );
+        BOOST_CHECK( multipliers == transMult.getConnectionMultipliers( connection.first, 4 ) );
+        BOOST_REQUIRE_EQUAL( multipliers.size(), nx * ny * nz );
+
+        for (size_t k = 0; k < nz; k++) {
+            for (size_t j = 0; j < ny; j++) {
+                for (size_t i = 0; i < nx; i++) {
+                    const size_t g = i + j * nx + k * nx * ny;
+                    size_t neighbour;
+                    bool boundary;
+                    if (connection.first == Opm::FaceDir::XPlus) {
+                        boundary = i + 1 == nx;
+                        neighbour = g + 1;
+                    } else if (connection.first == Opm::FaceDir::YPlus) {
+                        boundary = j + 1 == ny;
+                        neighbour = g + nx;
+                    } else {
+                        boundary = k + 1 == nz;
+                        neighbour = g + nx * ny;
+                    }
+
+                    if (boundary)
+                        BOOST_CHECK_EQUAL( multipliers[g], 1.0 );
+                    else
+                        BOOST_CHECK_CLOSE( multipliers[g],
+                                           transMult.getMultiplier( g, connection.first ) *
+                                           transMult.getMultiplier( neighbour, connection.second ) *
+                                           transMult.getRegionMultiplier( g, neighbour, connection.first ),
+                                           1e-12 );
+                }
+            }
+        }
+    }
+
+    BOOST_CHECK_THROW( transMult.getConnectionMultipliers( Opm::FaceDir::XMinus ), std::invalid_argument );
+}
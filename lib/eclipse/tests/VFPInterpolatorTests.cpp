@@ -0,0 +1,326 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE VFPInterpolatorTests
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/VFPInjTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/VFPInterpolator.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/VFPProdTable.hpp>
+#include <opm/parser/eclipse/Units/UnitSystem.hpp>
+
+using namespace Opm;
+
+namespace {
+
+/*
+ * Straightforward multilinear interpolation directly on the tables, to
+ * compare the interpolators with: every axis is searched linearly, and
+ * all the corners of the hypercube are summed with their weights.
+ */
+struct Weight {
+    size_t index;
+    size_t upper;
+    double lo, hi;
+    double dlo, dhi;
+};
+
+Weight weight( const std::vector< double >& axis, double x ) {
+    if( axis.size() == 1 )
+        return Weight{ 0, 0, 1, 0, 0, 0 };
+
+    size_t i = 0;
+    while( i + 2 < axis.size() && x >= axis[ i + 1 ] )
+        ++i;
+
+    const double width = axis[ i + 1 ] - axis[ i ];
+    const double t = (x - axis[ i ]) / width;
+    return Weight{ i, i + 1, 1 - t, t, -1 / width, 1 / width };
+}
+
+/* value followed by the derivatives along each axis */
+template< size_t N, typename Lookup >
+std::array< double, N + 1 > bruteForce( const std::array< Weight, N >& weights, Lookup lookup ) {
+    std::array< double, N + 1 > result;
+    result.fill( 0 );
+
+    for( size_t c = 0; c < (size_t( 1 ) << N); ++c ) {
+        std::array< size_t, N > index;
+        double w = 1;
+        for( size_t k = 0; k < N; ++k ) {
+            const bool upper = (c >> k) & 1;
+            index[ k ] = upper ? weights[ k ].upper : weights[ k ].index;
+            w *= upper ? weights[ k ].hi : weights[ k ].lo;
+        }
+
+        const double value = lookup( index );
+        result[ 0 ] += w * value;
+
+        for( size_t a = 0; a < N; ++a ) {
+            double dw = 1;
+            for( size_t k = 0; k < N; ++k ) {
+                const bool upper = (c >> k) & 1;
+                if( k == a )
+                    dw *= upper ? weights[ k ].dhi : weights[ k ].dlo;
+                else
+                    dw *= upper ? weights[ k ].hi : weights[ k ].lo;
+            }
+            result[ a + 1 ] += dw * value;
+        }
+    }
+
+    return result;
+}
+
+void checkClose( double value, double expected ) {
+    BOOST_CHECK_SMALL( (value - expected) / std::max( 1.0, std::abs( expected ) ), 1e-10 );
+}
+
+/* uniform samples of the axis, extended by a quarter at each end */
+double sample( const std::vector< double >& axis, std::mt19937& rng ) {
+    const double span = std::max( axis.back() - axis.front(), 1.0 );
+    std::uniform_real_distribution< double > dist( axis.front() - 0.25 * span,
+                                                   axis.back() + 0.25 * span );
+    return dist( rng );
+}
+
+void checkProd( const VFPProdTable& table ) {
+    const VFPProdInterpolator interpolator( table );
+    const auto& data = table.getTable();
+
+    std::mt19937 rng( 42 );
+    std::vector< double > flo, thp, wfr, gfr, alq;
+    for( int i = 0; i < 500; ++i ) {
+        flo.push_back( sample( table.getFloAxis(), rng ) );
+        thp.push_back( sample( table.getTHPAxis(), rng ) );
+        wfr.push_back( sample( table.getWFRAxis(), rng ) );
+        gfr.push_back( sample( table.getGFRAxis(), rng ) );
+        alq.push_back( sample( table.getALQAxis(), rng ) );
+    }
+
+    const auto values = interpolator.bhp( flo, thp, wfr, gfr, alq );
+    const auto evaluations = interpolator.evaluate( flo, thp, wfr, gfr, alq );
+
+    for( size_t i = 0; i < flo.size(); ++i ) {
+        const std::array< Weight, 5 > weights = {{
+            weight( table.getTHPAxis(), thp[ i ] ),
+            weight( table.getWFRAxis(), wfr[ i ] ),
+            weight( table.getGFRAxis(), gfr[ i ] ),
+            weight( table.getALQAxis(), alq[ i ] ),
+            weight( table.getFloAxis(), flo[ i ] )
+        }};
+
+        const auto expected = bruteForce< 5 >( weights, [&data]( const std::array< size_t, 5 >& index ) {
+            return data[ index[ 0 ] ][ index[ 1 ] ][ index[ 2 ] ][ index[ 3 ] ][ index[ 4 ] ];
+        });
+
+        const auto evaluation = interpolator.evaluate( flo[ i ], thp[ i ], wfr[ i ], gfr[ i ], alq[ i ] );
+        checkClose( interpolator.bhp( flo[ i ], thp[ i ], wfr[ i ], gfr[ i ], alq[ i ] ), expected[ 0 ] );
+        checkClose( evaluation.value, expected[ 0 ] );
+        checkClose( evaluation.dthp, expected[ 1 ] );
+        checkClose( evaluation.dwfr, expected[ 2 ] );
+        checkClose( evaluation.dgfr, expected[ 3 ] );
+        checkClose( evaluation.dalq, expected[ 4 ] );
+        checkClose( evaluation.dflo, expected[ 5 ] );
+
+        BOOST_CHECK_EQUAL( values[ i ], evaluation.value );
+        BOOST_CHECK_EQUAL( evaluations[ i ].value, evaluation.value );
+        BOOST_CHECK_EQUAL( evaluations[ i ].dflo, evaluation.dflo );
+        BOOST_CHECK_EQUAL( evaluations[ i ].dwfr, evaluation.dwfr );
+    }
+
+    /* the table nodes are reproduced exactly */
+    for( size_t t = 0; t < table.getTHPAxis().size(); ++t )
+        for( size_t f = 0; f < table.getFloAxis().size(); ++f )
+            BOOST_CHECK_CLOSE( interpolator.bhp( table.getFloAxis()[ f ],
+                                                 table.getTHPAxis()[ t ],
+                                                 table.getWFRAxis().back(),
+                                                 table.getGFRAxis().front(),
+                                                 table.getALQAxis().back() ),
+                               data[ t ][ table.getWFRAxis().size() - 1 ][ 0 ][ table.getALQAxis().size() - 1 ][ f ],
+                               1e-10 );
+}
+
+}
+
+
+BOOST_AUTO_TEST_CASE( VFPAxisFind ) {
+    const VFPAxis axis( { 1.0, 2.0, 4.0 } );
+    BOOST_CHECK_EQUAL( axis.size(), 3U );
+
+    auto bracket = axis.find( 3.0 );
+    BOOST_CHECK_EQUAL( bracket.index, 1U );
+    BOOST_CHECK_CLOSE( bracket.factor, 0.5, 1e-12 );
+    BOOST_CHECK_CLOSE( bracket.inverseWidth, 0.5, 1e-12 );
+
+    bracket = axis.find( 2.0 );
+    BOOST_CHECK_EQUAL( bracket.index, 1U );
+    BOOST_CHECK_EQUAL( bracket.factor, 0.0 );
+
+    /* linear extrapolation from the end intervals */
+    bracket = axis.find( 0.0 );
+    BOOST_CHECK_EQUAL( bracket.index, 0U );
+    BOOST_CHECK_CLOSE( bracket.factor, -1.0, 1e-12 );
+
+    bracket = axis.find( 8.0 );
+    BOOST_CHECK_EQUAL( bracket.index, 1U );
+    BOOST_CHECK_CLOSE( bracket.factor, 3.0, 1e-12 );
+
+    const VFPAxis single( { 5.0 } );
+    bracket = single.find( 7.0 );
+    BOOST_CHECK_EQUAL( bracket.index, 0U );
+    BOOST_CHECK_EQUAL( bracket.factor, 0.0 );
+    BOOST_CHECK_EQUAL( bracket.inverseWidth, 0.0 );
+
+    BOOST_CHECK_THROW( VFPAxis( std::vector< double >() ), std::invalid_argument );
+    BOOST_CHECK_THROW( VFPAxis( { 1.0, 1.0 } ), std::invalid_argument );
+    BOOST_CHECK_THROW( VFPAxis( { 2.0, 1.0 } ), std::invalid_argument );
+}
+
+
+BOOST_AUTO_TEST_CASE( VFPProdInterpolation ) {
+    const std::vector< double > flo = { 1, 2, 5, 10, 20, 50 };
+    const std::vector< double > thp = { 10, 20, 40, 80 };
+    const std::vector< double > wfr = { 0, 0.5, 0.9 };
+    const std::vector< double > gfr = { 50, 100, 200, 400, 800 };
+    const std::vector< double > alq = { 0 };
+
+    VFPProdTable::extents shape;
+    shape[ 0 ] = thp.size();
+    shape[ 1 ] = wfr.size();
+    shape[ 2 ] = gfr.size();
+    shape[ 3 ] = alq.size();
+    shape[ 4 ] = flo.size();
+    VFPProdTable::array_type data( shape );
+
+    std::mt19937 rng( 17 );
+    std::uniform_real_distribution< double > dist( 10, 100 );
+    std::generate( data.data(), data.data() + data.num_elements(), [&]() { return dist( rng ); } );
+
+    VFPProdTable table;
+    table.init( 1, 1000.0,
+                VFPProdTable::FLO_LIQ, VFPProdTable::WFR_WCT,
+                VFPProdTable::GFR_GOR, VFPProdTable::ALQ_UNDEF,
+                flo, thp, wfr, gfr, alq, data );
+
+    checkProd( table );
+
+    const VFPProdInterpolator interpolator( table );
+    BOOST_CHECK_THROW( interpolator.bhp( { 1.0, 2.0 }, { 10.0 }, { 0.0 }, { 50.0 }, { 0.0 } ),
+                       std::invalid_argument );
+    const std::vector< double > none;
+    BOOST_CHECK( interpolator.bhp( none, none, none, none, none ).empty() );
+}
+
+
+BOOST_AUTO_TEST_CASE( VFPProdInterpolationDeck ) {
+    const char *deckData = "\
+VFPPROD \n\
+      5  32.9  'LIQ' 'WCT' 'GOR' 'THP' ' ' 'METRIC' 'BHP'  / \n\
+1 3 5 /      \n\
+7 11 /       \n\
+13 17 /      \n\
+19 23 /      \n\
+29 31 /      \n\
+1 1 1 1 1.5 2.5 3.5 /    \n\
+2 1 1 1 4.5 5.5 6.5 /    \n\
+1 2 1 1 7.5 8.5 9.5 /    \n\
+2 2 1 1 10.5 11.5 12.5 / \n\
+1 1 2 1 13.5 14.5 15.5 / \n\
+2 1 2 1 16.5 17.5 18.5 / \n\
+1 2 2 1 19.5 20.5 21.5 / \n\
+2 2 2 1 22.5 23.5 24.5 / \n\
+1 1 1 2 25.5 26.5 27.5 / \n\
+2 1 1 2 28.5 29.5 30.5 / \n\
+1 2 1 2 31.5 32.5 33.5 / \n\
+2 2 1 2 34.5 35.5 36.5 / \n\
+1 1 2 2 37.5 38.5 39.5 / \n\
+2 1 2 2 40.5 41.5 42.5 / \n\
+1 2 2 2 43.5 44.5 45.5 / \n\
+2 2 2 2 46.5 47.5 48.5 / \n";
+
+    Parser parser;
+    const auto deck = parser.parseString( deckData, ParseContext() );
+
+    VFPProdTable table;
+    table.init( deck.getKeyword( "VFPPROD" ), UnitSystem::newMETRIC() );
+
+    checkProd( table );
+}
+
+
+BOOST_AUTO_TEST_CASE( VFPInjInterpolation ) {
+    const char *deckData = "\
+VFPINJ \n\
+       5  32.9   WAT   THP METRIC   BHP /  \n\
+1 3 5 10 /   \n\
+7 11 20 /    \n\
+1 1.5 2.5 3.5 7.0 /    \n\
+2 4.5 5.5 6.5 9.0 /    \n\
+3 5.0 8.5 9.0 9.5 /    \n";
+
+    Parser parser;
+    const auto deck = parser.parseString( deckData, ParseContext() );
+
+    VFPInjTable table;
+    table.init( deck.getKeyword( "VFPINJ" ), UnitSystem::newMETRIC() );
+
+    const VFPInjInterpolator interpolator( table );
+    const auto& data = table.getTable();
+
+    std::mt19937 rng( 7 );
+    std::vector< double > flo, thp;
+    for( int i = 0; i < 200; ++i ) {
+        flo.push_back( sample( table.getFloAxis(), rng ) );
+        thp.push_back( sample( table.getTHPAxis(), rng ) );
+    }
+
+    const auto values = interpolator.bhp( flo, thp );
+    const auto evaluations = interpolator.evaluate( flo, thp );
+
+    for( size_t i = 0; i < flo.size(); ++i ) {
+        const std::array< Weight, 2 > weights = {{
+            weight( table.getTHPAxis(), thp[ i ] ),
+            weight( table.getFloAxis(), flo[ i ] )
+        }};
+
+        const auto expected = bruteForce< 2 >( weights, [&data]( const std::array< size_t, 2 >& index ) {
+            return data[ index[ 0 ] ][ index[ 1 ] ];
+        });
+
+        checkClose( values[ i ], expected[ 0 ] );
+        checkClose( evaluations[ i ].value, expected[ 0 ] );
+        checkClose( evaluations[ i ].dthp, expected[ 1 ] );
+        checkClose( evaluations[ i ].dflo, expected[ 2 ] );
+        BOOST_CHECK_EQUAL( evaluations[ i ].dwfr, 0.0 );
+        BOOST_CHECK_EQUAL( interpolator.bhp( flo[ i ], thp[ i ] ), values[ i ] );
+    }
+
+    BOOST_CHECK_THROW( interpolator.evaluate( flo, std::vector< double >() ), std::invalid_argument );
+}
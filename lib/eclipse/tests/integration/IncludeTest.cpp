@@ -189,3 +189,53 @@ BOOST_AUTO_TEST_CASE(parse_fileWithPathsKeyword_IncludeExtendsPath) {
     BOOST_CHECK( deck.hasKeyword("BOX"));
 }
 
+
+BOOST_AUTO_TEST_CASE(parse_includeWithCommentsAndNoTrailingNewline) {
+    path root = temp_directory_path() / unique_path("%%%%-%%%%");
+    path datafile = root / "TEST.DATA";
+    path gridInclude = root / "grid.include";
+    create_directories(root);
+
+    const std::string gridInput = "DIMENS -- the dimensions\n"
+                                  " 2 1 1 / garbage after the slash\n"
+                                  "PORO\n"
+                                  "  0.10 -- first cell\n"
+                                  "-- a comment between the values\n"
+                                  "  0.20 / 'quoted garbage\n"
+                                  "MULTPV\n"
+                                  "  2*1.5 /";
+    {
+        std::ofstream of(datafile.string().c_str());
+        of << "INCLUDE" << std::endl;
+        of << "  'grid.include' /" << std::endl;
+        of << "START" << std::endl;
+        of << "   10 'FEB' 2012 /" << std::endl;
+    }
+    {
+        std::ofstream of(gridInclude.string().c_str());
+        of << gridInput;
+    }
+
+    Parser parser;
+    auto deck = parser.parseFile(datafile.string(), ParseContext());
+
+    BOOST_CHECK_EQUAL( 2, deck.getKeyword("DIMENS").getRecord(0).getItem(0).get< int >(0) );
+    BOOST_CHECK_EQUAL( 1, deck.getKeyword("DIMENS").getRecord(0).getItem(2).get< int >(0) );
+
+    const auto& poro = deck.getKeyword("PORO").getRawDoubleData();
+    BOOST_CHECK_EQUAL( 2U, poro.size() );
+    BOOST_CHECK_CLOSE( 0.10, poro[0], 1e-12 );
+    BOOST_CHECK_CLOSE( 0.20, poro[1], 1e-12 );
+
+    const auto& multpv = deck.getKeyword("MULTPV").getRawDoubleData();
+    BOOST_CHECK_EQUAL( 2U, multpv.size() );
+    BOOST_CHECK_CLOSE( 1.5, multpv[1], 1e-12 );
+
+    BOOST_CHECK( deck.hasKeyword("START") );
+
+    /* The input is cleaned in place, but that must never reach the file. */
+    std::ifstream is(gridInclude.string().c_str());
+    const std::string onDisk( (std::istreambuf_iterator< char >( is )),
+                              std::istreambuf_iterator< char >() );
+    BOOST_CHECK_EQUAL( gridInput, onDisk );
+}
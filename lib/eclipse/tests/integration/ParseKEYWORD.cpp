@@ -22,6 +22,8 @@
 #include <boost/test/unit_test.hpp>
 
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/NNC.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/TransMult.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/SgofTable.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/SlgofTable.hpp>
@@ -438,6 +440,17 @@ BOOST_AUTO_TEST_CASE( MULTREGT_ECLIPSE_STATE ) {
     // The 2 4 0.75 Z input is overwritten by 2 4 2.5 XY, ==) that 2 4 Z returns the 4 2 value = 0.6
     BOOST_CHECK_EQUAL( 0.60 , transMult.getRegionMultiplier( 7 , 3 , FaceDir::DirEnum::XPlus));
     BOOST_CHECK_EQUAL( 0.60 , transMult.getRegionMultiplier( 3 , 7 , FaceDir::DirEnum::ZPlus));
+
+    // The multipliers of all faces at once
+    const auto x = transMult.getRegionMultipliers( FaceDir::DirEnum::XPlus );
+    const auto z = transMult.getRegionMultipliers( FaceDir::DirEnum::ZPlus );
+    BOOST_CHECK( x == std::vector< double >( { 0.10, 1.0, 0.10, 1.0, 1.00, 1.0, 1.00, 1.0 } ) );
+    BOOST_CHECK( z == std::vector< double >( { 1.50, 0.6, 1.50, 0.6, 1.00, 1.0, 1.00, 1.0 } ) );
+
+    NNC nnc;
+    nnc.addNNC( 0, 3, 1.0 );
+    nnc.addNNC( 4, 7, 1.0 );
+    BOOST_CHECK( transMult.getRegionMultipliers( nnc ) == std::vector< double >( { 1.00, 0.50 } ) );
 }
 
 BOOST_AUTO_TEST_CASE( MULTISEGMENT_ABS ) {